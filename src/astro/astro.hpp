@@ -24,6 +24,7 @@
 #include "julian_day.hpp"
 #include "delta_t.hpp"
 #include "earth.hpp"
+#include "epoch.hpp"
 #include "sun.hpp"
 #include "moon.hpp"
 #include "moon_phase.hpp"
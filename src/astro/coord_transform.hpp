@@ -27,6 +27,7 @@
 #include <cmath>
 
 #include "toolbox.hpp"
+#include "epoch.hpp"
 
 
 namespace astro::coords {
@@ -100,6 +101,21 @@ inline auto ecliptic_to_equatorial(
   };
 }
 
+/**
+ * @brief Convert apparent ecliptic coordinates (λ, β) to apparent equatorial coordinates (α, δ), at an epoch.
+ * @param λ The apparent ecliptic longitude.
+ * @param β The apparent ecliptic latitude.
+ * @param ctx The context of the epoch, whose true obliquity (ε₀ + Δε) is used; see `astro::epoch::make_context`.
+ * @return The equatorial coordinates (α, δ); α is normalized to [0°, 360°).
+ */
+inline auto ecliptic_to_equatorial(
+  const astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG>& λ,
+  const astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG>& β,
+  const astro::epoch::EpochContext& ctx
+) -> EquatorialCoord {
+  return ecliptic_to_equatorial(λ, β, ctx.ε);
+}
+
 /**
  * @brief Convert equatorial coordinates (H, δ) to horizontal coordinates (A, h) for an observer at latitude φ.
  * @param H The local hour angle of the object, measured westward from the meridian.
@@ -0,0 +1,534 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <cstdint>
+#include <numbers>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include "simd.hpp"
+#include "julian_day.hpp"
+#include "loader.hpp"
+
+// The full lunar theory ELP/MPP02 (Chapront & Francou, 2003), i.e. the main problem and all the planetary perturbations,
+// about 35,000 terms, against the 60 + 60 terms of the truncation of Meeus in `elp2000_82b.hpp`.
+//
+// Every term is reduced to x·t^k·sin(φ0 + φ1·t + φ2·t² + φ3·t³ + φ4·t⁴) when the series are built, with x >= 0.
+// The terms of a variable and a power of t are stored in structure-of-arrays layout, sorted by decreasing x,
+// so a runtime amplitude threshold keeps a prefix of every table, and the SIMD kernel evaluates `simd::LANES` terms at a time.
+//
+// @ref J. Chapront, G. Francou, "The lunar theory ELP revisited. Introduction of new planetary perturbations", A&A 404, 2003.
+// @ref The FORTRAN reference implementation ELPMPP02.for, from ftp://cyrano-se.obspm.fr/pub/2_lunar_solutions/2_elpmpp02/.
+
+namespace astro::elpmpp02 {
+
+#pragma region Constants
+
+/** @brief The number of arcseconds in a radian. */
+constexpr double ARCSEC_PER_RAD = 648000.0 / std::numbers::pi;
+
+/** @brief The mean distance of the Moon, in KM, to compare the distance terms with the angle terms. */
+constexpr double MEAN_DISTANCE = 385000.56;
+
+/** @enum The fit of the constants of the theory. */
+enum class Fit : uint8_t {
+  DE405, // Fitted to JPL DE405 over 1950-2060. Recommended for long periods of time.
+  LLR,   // Fitted to the Lunar Laser Ranging observations over 1970-2007.
+};
+
+/** @brief The polynomial of an argument, in radians, of t in julian centuries since J2000. */
+using Polynomial = std::array<double, 5>;
+
+/** @brief Return the polynomial with the coefficients in arcseconds, converted to radians. */
+constexpr auto from_arcsec(const Polynomial& arcsec) -> Polynomial {
+  Polynomial rad {};
+  for (std::size_t k = 0; k < rad.size(); ++k) {
+    rad.at(k) = arcsec.at(k) / ARCSEC_PER_RAD;
+  }
+  return rad;
+}
+
+/** @brief Return the angle in degrees, minutes and arcseconds, in arcseconds. */
+constexpr auto dms(const double deg, const double min, const double sec) -> double {
+  return (deg * 60.0 + min) * 60.0 + sec;
+}
+
+
+/** @struct The fundamental arguments of the theory, with the corrections of the fit applied. */
+struct Arguments {
+  Polynomial W1;                    // The mean longitude of the Moon, referred to the inertial mean ecliptic of J2000.
+  std::array<Polynomial, 4> Δ;      // The Delaunay arguments D, F, l and l'.
+  std::array<Polynomial, 8> planets; // The mean longitudes of Mercury to Neptune.
+  Polynomial ζ;                     // W1 plus the general precession in longitude.
+
+  // The corrections to the amplitudes of the main problem, for the fitted constants.
+  double Δν;  // The mean motion of the Moon.
+  double Δe;  // The eccentricity of the Moon.
+  double Δγ;  // The inclination of the Moon.
+  double Δnp; // The mean motion of the EMB.
+  double Δep; // The eccentricity of the EMB.
+  double m;   // The ratio of the mean motions of the EMB and the Moon.
+  double δ;   // 2α/3m, where α is the ratio of the semi-major axes of the Moon and the EMB.
+};
+
+/**
+ * @brief Create the fundamental arguments of the given fit.
+ * @see `INITIAL` of ELPMPP02.for.
+ */
+inline auto create_arguments(const Fit fit) -> Arguments {
+  // The corrections of the fit, in arcseconds, and arcseconds per century for the rates.
+  struct Corrections {
+    Polynomial W1, W2, W3; // The corrections to the polynomials of W1, W2 and W3.
+    double T0, T1;         // The corrections to the constant term and the rate of T, the mean longitude of the EMB.
+    double ϖp;             // The correction to the constant term of ϖ', the longitude of the perihelion of the EMB.
+    double γ, e, ep;       // The corrections to the inclination, the eccentricity of the Moon and of the EMB.
+  };
+  const Corrections Δ = fit == Fit::DE405
+    ? Corrections {
+        .W1 = { -0.10525, -0.32311, -0.03794, 0.0, 0.0 },
+        .W2 = {  0.16826,  0.08017,  0.0,     0.0, 0.0 },
+        .W3 = { -0.10760, -0.04317,  0.0,     0.0, 0.0 },
+        .T0 = -0.04012, .T1 = 0.01442, .ϖp = -0.04854, .γ = 0.00069, .e = 0.00005, .ep = 0.00226,
+      }
+    : Corrections {
+        .W1 = { -0.07008, -0.35106, -0.03743, -0.00018865, -0.00001024 },
+        .W2 = {  0.20794,  0.08017,  0.00470602, -0.00025213, 0.0 },
+        .W3 = { -0.07215, -0.04317, -0.00261070, -0.00010712, 0.0 },
+        .T0 = -0.00033, .T1 = 0.00732, .ϖp = -0.00749, .γ = 0.00085, .e = -0.00006, .ep = 0.00224,
+      };
+
+  const auto corrected = [](Polynomial arcsec, const Polynomial& correction) {
+    for (std::size_t k = 0; k < arcsec.size(); ++k) {
+      arcsec.at(k) += correction.at(k);
+    }
+    return from_arcsec(arcsec);
+  };
+
+  // The mean longitude of the Moon, the longitude of its perigee and of its node.
+  const Polynomial W1 = corrected({ dms(218, 18, 59.95571), 1732559343.73604, -6.8084, 0.66040e-2, -0.31690e-4 }, Δ.W1);
+  Polynomial W2 = corrected({ dms(83, 21, 11.67475), 14643420.3171, -38.2631, -0.45047e-1, 0.21301e-3 }, Δ.W2);
+  Polynomial W3 = corrected({ dms(125, 2, 40.39816), -6967919.5383, 6.3590, 0.76250e-2, -0.35860e-4 }, Δ.W3);
+  // The mean longitude of the EMB, and the longitude of its perihelion.
+  const Polynomial T = corrected({ dms(100, 27, 59.13885), 129597742.293, -0.0202, 0.90e-5, 0.15e-6 }, { Δ.T0, Δ.T1, 0.0, 0.0, 0.0 });
+  const Polynomial ϖp = corrected({ dms(102, 56, 14.45766), 1161.24342, 0.529, -0.1e-3, 0.0 }, { Δ.ϖp, 0.0, 0.0, 0.0, 0.0 });
+
+  // The corrections to the rates of W2 and W3, inferred from the corrections of the constants.
+  constexpr double m = 0.074801329;
+  constexpr double α = 0.002571881;
+  constexpr double δ = 2.0 * α / (3.0 * m);
+  constexpr std::array<std::array<double, 5>, 2> Bp {{
+    { 0.311079095, -0.4482398e-2, -0.110248500e-2,  0.1056062e-2,  0.50928e-4 },
+    { -0.103837907, 0.6682870e-3, -0.129807200e-2, -0.1780280e-3, -0.37342e-4 },
+  }};
+  for (std::size_t i = 0; i < Bp.size(); ++i) {
+    Polynomial& W = i == 0 ? W2 : W3;
+    const auto& bp = Bp.at(i);
+    const double y = m * bp[0] + 2.0 * α / 3.0 * bp[4];
+    const double correction = (W[1] / W1[1] - y) * Δ.W1[1] + y / m * Δ.T1
+                            + W1[1] * (bp[1] * Δ.γ + bp[2] * Δ.e + bp[3] * Δ.ep);
+    W[1] += correction / ARCSEC_PER_RAD;
+  }
+
+  Arguments arguments {};
+  arguments.W1 = W1;
+  for (std::size_t k = 0; k < W1.size(); ++k) {
+    arguments.Δ[0].at(k) = W1.at(k) - T.at(k);  // D
+    arguments.Δ[1].at(k) = W1.at(k) - W3.at(k); // F
+    arguments.Δ[2].at(k) = W1.at(k) - W2.at(k); // l
+    arguments.Δ[3].at(k) = T.at(k) - ϖp.at(k);  // l'
+  }
+  arguments.Δ[0][0] += std::numbers::pi;
+
+  // The mean longitudes of the planets, with linear polynomials.
+  constexpr std::array<std::array<double, 2>, 8> PLANETS {{
+    { dms(252, 15,  3.216919), 538101628.66888 },
+    { dms(181, 58, 44.758419), 210664136.45777 },
+    { dms(100, 27, 59.138850), 129597742.29300 },
+    { dms(355, 26,  3.642778),  68905077.65936 },
+    { dms( 34, 21,  5.379392),  10925660.57335 },
+    { dms( 50,  4, 38.902495),   4399609.33632 },
+    { dms(314,  3,  4.354234),   1542482.57845 },
+    { dms(304, 20, 56.808371),    786547.89700 },
+  }};
+  for (std::size_t i = 0; i < PLANETS.size(); ++i) {
+    arguments.planets.at(i) = from_arcsec({ PLANETS.at(i)[0], PLANETS.at(i)[1], 0.0, 0.0, 0.0 });
+  }
+
+  // ζ, with the precession rate corrected.
+  arguments.ζ = W1;
+  arguments.ζ[1] += (5029.0966 - 0.29965) / ARCSEC_PER_RAD;
+
+  arguments.Δν  =  0.55604 / ARCSEC_PER_RAD / W1[1];
+  arguments.Δe  =  0.01789 / ARCSEC_PER_RAD;
+  arguments.Δγ  = -0.08066 / ARCSEC_PER_RAD;
+  arguments.Δnp = -0.06424 / ARCSEC_PER_RAD / W1[1];
+  arguments.Δep = -0.12879 / ARCSEC_PER_RAD;
+  arguments.m   = m;
+  arguments.δ   = δ;
+  return arguments;
+}
+
+#pragma endregion
+
+
+#pragma region Series
+
+/** @struct The evaluated series, referred to the mean ecliptic of date and the inertial departure point of J2000. */
+struct Evaluation {
+  double V; // The longitude, in radians, not normalized.
+  double U; // The latitude, in radians.
+  double r; // The distance, in KM.
+};
+
+/**
+ * @class The series of ELP/MPP02, built from the coefficients and a fit, ready to evaluate.
+ * @note A term is x·t^k·sin(φ0 + φ1·t + φ2·t² + φ3·t³ + φ4·t⁴), with x in arcseconds for the longitude and the latitude,
+ *       and in KM for the distance. The tables are aligned, zero-padded to full vectors, and sorted by decreasing x.
+ */
+class Series {
+public:
+  /**
+   * @brief Build the series.
+   * @param coefficients The coefficients, see `load_ascii` and `load_binary`.
+   * @param fit The fit of the constants.
+   */
+  explicit Series(const Coefficients& coefficients, const Fit fit = Fit::DE405) : _arguments { create_arguments(fit) } {
+    for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+      std::array<std::vector<Term>, POWERS> terms;
+      for (const MainTerm& term : coefficients.main.at(variable)) {
+        terms[0].push_back(reduce_main(term, variable));
+      }
+      for (std::size_t power = 0; power < POWERS; ++power) {
+        for (const PerturbationTerm& term : coefficients.perturbation.at(variable).at(power)) {
+          terms.at(power).push_back(reduce_perturbation(term));
+        }
+      }
+
+      for (std::size_t power = 0; power < POWERS; ++power) {
+        std::ranges::stable_sort(terms.at(power), std::greater {}, &Term::x);
+        _tables.at(variable).at(power) = Table::create(terms.at(power));
+        _term_count += terms.at(power).size();
+      }
+    }
+  }
+
+  /**
+   * @brief Evaluate the series.
+   * @param jc The julian century since J2000, based on TDB (i.e. TT).
+   * @param threshold The amplitude threshold, in arcseconds. Terms with x·|t|^k below it are skipped.
+   *                  The distance terms are compared as seen from the Earth, i.e. x / `MEAN_DISTANCE` in radians.
+   * @return The evaluated series.
+   * @note The arguments reach 10^5 radians per century, so |jc| must stay within a few hundred for `simd::sin`.
+   *       ELP/MPP02 itself is meant for a few thousand years around J2000.
+   */
+  [[nodiscard]] auto evaluate(const double jc, const double threshold = 0.0) const -> Evaluation {
+    std::array<double, VARIABLES> sums {};
+    for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+      double t_k = 1.0; // t^k.
+      for (std::size_t power = 0; power < POWERS; ++power, t_k *= jc) {
+        const Table& table = _tables.at(variable).at(power);
+        const std::size_t count = table.count(cutoff(variable, threshold, std::abs(t_k)));
+        sums.at(variable) += t_k * table.sum(count, jc);
+      }
+    }
+
+    const double W1 = std::fma(jc, std::fma(jc, std::fma(jc, std::fma(jc, _arguments.W1[4], _arguments.W1[3]), _arguments.W1[2]), _arguments.W1[1]), _arguments.W1[0]);
+    return {
+      .V = W1 + sums[0] / ARCSEC_PER_RAD,
+      .U = sums[1] / ARCSEC_PER_RAD,
+      .r = sums[2] * A405 / AELP,
+    };
+  }
+
+  /** @brief Return the number of terms `evaluate` sums with the given threshold and julian century, without the padding. */
+  [[nodiscard]] auto term_count(const double jc, const double threshold) const -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+      double t_k = 1.0;
+      for (std::size_t power = 0; power < POWERS; ++power, t_k *= jc) {
+        const Table& table = _tables.at(variable).at(power);
+        count += std::min(table.count(cutoff(variable, threshold, std::abs(t_k))), table.size);
+      }
+    }
+    return count;
+  }
+
+  /** @brief Return the total number of terms, without the padding. */
+  [[nodiscard]] auto term_count() const -> std::size_t { return _term_count; }
+
+  /** @brief Return the fundamental arguments. */
+  [[nodiscard]] auto arguments() const -> const Arguments& { return _arguments; }
+
+private:
+  // The semi-major axes of the Moon's orbit, of DE405 and of ELP, in KM, to scale the distance.
+  static constexpr double A405 = 384747.9613701725;
+  static constexpr double AELP = 384747.980674318;
+
+  /** @struct A reduced term, x·sin(φ0 + φ1·t + φ2·t² + φ3·t³ + φ4·t⁴). */
+  struct Term {
+    double x;
+    Polynomial φ;
+  };
+
+  /** @struct A table of terms, in structure-of-arrays layout. */
+  struct Table {
+    simd::AlignedVector x;
+    std::array<simd::AlignedVector, 5> φ;
+    std::size_t size { 0 }; // Without the padding.
+
+    static auto create(const std::vector<Term>& terms) -> Table {
+      Table table;
+      table.size = terms.size();
+      const std::size_t padded = simd::padded(terms.size());
+      table.x.resize(padded, 0.0);
+      for (auto& φ : table.φ) {
+        φ.resize(padded, 0.0);
+      }
+      for (std::size_t i = 0; i < terms.size(); ++i) {
+        table.x[i] = terms[i].x;
+        for (std::size_t k = 0; k < table.φ.size(); ++k) {
+          table.φ.at(k)[i] = terms[i].φ.at(k);
+        }
+      }
+      return table;
+    }
+
+    /** @brief Return the number of terms with x >= cutoff, rounded up to full vectors. */
+    [[nodiscard]] auto count(const double cutoff) const -> std::size_t {
+      const auto end = std::ranges::partition_point(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(size), [cutoff](const double x) { return x >= cutoff; });
+      return simd::padded(static_cast<std::size_t>(end - x.begin()));
+    }
+
+    /** @brief Return Σ x·sin(φ(t)) of the first `count` terms, `count` being a multiple of `simd::LANES`. */
+    [[nodiscard]] auto sum(const std::size_t count, const double t) const -> double {
+      const auto& [φ0, φ1, φ2, φ3, φ4] = φ;
+      simd::VecD sum {};
+      for (std::size_t i = 0; i < count; i += simd::LANES) {
+        const simd::VecD θ = simd::load(φ0, i) + t * (simd::load(φ1, i) + t * (simd::load(φ2, i) + t * (simd::load(φ3, i) + t * simd::load(φ4, i))));
+        sum += simd::load(x, i) * simd::sin(θ);
+      }
+      return simd::accumulate(sum, 0.0);
+    }
+  };
+
+  Arguments _arguments;
+  std::array<std::array<Table, POWERS>, VARIABLES> _tables;
+  std::size_t _term_count { 0 };
+
+  /** @brief Return the smallest x of the terms of t^k to evaluate, given |t|^k. */
+  static auto cutoff(const std::size_t variable, const double threshold, const double t_k) -> double {
+    if (threshold <= 0.0) {
+      return 0.0;
+    }
+    if (t_k == 0.0) {
+      return INFINITY; // The terms vanish.
+    }
+    const double scale = variable == 2 ? MEAN_DISTANCE / ARCSEC_PER_RAD : 1.0; // Arcseconds to KM, for the distance.
+    return threshold * scale / t_k;
+  }
+
+  /** @brief Return the term with x >= 0, and φ0 reduced to [-π, π]. */
+  static auto normalized(Term term) -> Term {
+    if (term.x < 0.0) {
+      term.x = -term.x;
+      term.φ[0] += std::numbers::pi;
+    }
+    term.φ[0] = std::remainder(term.φ[0], 2.0 * std::numbers::pi);
+    return term;
+  }
+
+  /** @brief Reduce a term of the main problem, with the corrections of the fitted constants. */
+  [[nodiscard]] auto reduce_main(const MainTerm& term, const std::size_t variable) const -> Term {
+    const Arguments& arg = _arguments;
+    const auto& B = term.B;
+
+    double A = term.A;
+    if (variable == 2) {
+      A -= 2.0 * A * arg.Δν / 3.0;
+    }
+    const double x = A + (B[0] + arg.δ * B[4]) * (arg.Δnp - arg.m * arg.Δν) + B[1] * arg.Δγ + B[2] * arg.Δe + B[3] * arg.Δep;
+
+    Polynomial φ {};
+    for (std::size_t i = 0; i < term.multipliers.size(); ++i) {
+      for (std::size_t k = 0; k < φ.size(); ++k) {
+        φ.at(k) += term.multipliers.at(i) * arg.Δ.at(i).at(k);
+      }
+    }
+    if (variable == 2) {
+      φ[0] += std::numbers::pi / 2; // A cosine.
+    }
+    return normalized({ .x = x, .φ = φ });
+  }
+
+  /** @brief Reduce a term of the perturbations, S·sin(θ) + C·cos(θ) = √(S² + C²)·sin(θ + atan2(C, S)). */
+  [[nodiscard]] auto reduce_perturbation(const PerturbationTerm& term) const -> Term {
+    const Arguments& arg = _arguments;
+    const auto& i = term.multipliers;
+
+    Polynomial φ {};
+    φ[0] = std::atan2(term.C, term.S);
+    for (std::size_t k = 0; k < φ.size(); ++k) {
+      for (std::size_t j = 0; j < arg.Δ.size(); ++j) {
+        φ.at(k) += i.at(j) * arg.Δ.at(j).at(k);
+      }
+      for (std::size_t j = 0; j < arg.planets.size(); ++j) {
+        φ.at(k) += i.at(4 + j) * arg.planets.at(j).at(k);
+      }
+      φ.at(k) += i[12] * arg.ζ.at(k);
+    }
+    return normalized({ .x = std::hypot(term.S, term.C), .φ = φ });
+  }
+};
+
+#pragma endregion
+
+
+#pragma region Frames
+
+/**
+ * @brief Rotate the position from the mean ecliptic of date to the inertial mean ecliptic and equinox of J2000.
+ * @param evaluated The evaluated series.
+ * @param jc The julian century since J2000.
+ * @return The rectangular coordinates, in KM.
+ * @ref The precession of Laskar, with the P and Q of Simon et al. (1994), as in ELPMPP02.for.
+ */
+inline auto to_j2000(const Evaluation& evaluated, const double jc) -> std::array<double, 3> {
+  const double x1 = evaluated.r * std::cos(evaluated.V) * std::cos(evaluated.U);
+  const double x2 = evaluated.r * std::sin(evaluated.V) * std::cos(evaluated.U);
+  const double x3 = evaluated.r * std::sin(evaluated.U);
+
+  const double P = (0.10180391e-4 + jc * (0.47020439e-6 + jc * (-0.5417367e-9 + jc * (-0.2507948e-11 + jc * 0.463486e-14)))) * jc;
+  const double Q = (-0.113469002e-3 + jc * (0.12372674e-6 + jc * (0.1265417e-8 + jc * (-0.1371808e-11 + jc * -0.320334e-14)))) * jc;
+  const double ra = 2.0 * std::sqrt(1.0 - P * P - Q * Q);
+  const double pq = 2.0 * P * Q;
+  const double p2 = 1.0 - 2.0 * P * P;
+  const double q2 = 1.0 - 2.0 * Q * Q;
+
+  return {
+    p2 * x1 + pq * x2 + P * ra * x3,
+    pq * x1 + q2 * x2 - Q * ra * x3,
+    -P * ra * x1 + Q * ra * x2 + (p2 + q2 - 1.0) * x3,
+  };
+}
+
+/** @struct The geometric ecliptic coordinates of the Moon. */
+struct EclipticCoord {
+  double λ; // The longitude, in radians, in [0, 2π).
+  double β; // The latitude, in radians.
+  double r; // The distance, in KM.
+};
+
+/**
+ * @brief Precess the rectangular coordinates of J2000 to the mean ecliptic and equinox of date.
+ * @param xyz The rectangular coordinates referred to the mean ecliptic and equinox of J2000.
+ * @param jc The julian century since J2000.
+ * @return The spherical coordinates of date.
+ * @ref Jean Meeus, "Astronomical Algorithms", Second Edition, Chapter 21, formulae 21.5 with T = 0.
+ */
+inline auto precess_from_j2000(const std::array<double, 3>& xyz, const double jc) -> EclipticCoord {
+  const auto [x, y, z] = xyz;
+  const double r  = std::hypot(x, y, z);
+  const double λ0 = std::atan2(y, x);
+  const double β0 = std::asin(z / r);
+
+  const double η = (47.0029 + jc * (-0.03302 + jc * 0.000060)) * jc / ARCSEC_PER_RAD;
+  const double Π = (dms(174, 52, 34.982) + jc * (-869.8089 + jc * 0.03536)) / ARCSEC_PER_RAD;
+  const double p = (5029.0966 + jc * (1.11113 - jc * 0.000006)) * jc / ARCSEC_PER_RAD;
+
+  const double A = std::cos(η) * std::cos(β0) * std::sin(Π - λ0) - std::sin(η) * std::sin(β0);
+  const double B = std::cos(β0) * std::cos(Π - λ0);
+  const double C = std::cos(η) * std::sin(β0) + std::sin(η) * std::cos(β0) * std::sin(Π - λ0);
+
+  const double λ = p + Π - std::atan2(A, B);
+  return {
+    .λ = λ - 2.0 * std::numbers::pi * std::floor(λ / (2.0 * std::numbers::pi)),
+    .β = std::asin(C),
+    .r = r,
+  };
+}
+
+#pragma endregion
+
+
+#pragma region Registry
+
+/** @brief The registered series, see `load`. Empty until loaded. */
+inline std::optional<Series> LOADED_SERIES;
+
+/** @brief Serialize the registration. */
+inline std::mutex LOAD_MUTEX;
+
+/**
+ * @brief Load the compact binary file of ELP/MPP02, and register the series.
+ * @param path The path to the file, see `convert_elpmpp02`.
+ * @param fit The fit of the constants.
+ * @throw std::runtime_error If the series are already loaded, or the file cannot be loaded.
+ * @note The series can be loaded only once, so they never change while they are evaluated.
+ *       Load them before evaluating them on other threads.
+ */
+inline void load(const std::filesystem::path& path, const Fit fit = Fit::DE405) {
+  const std::lock_guard lock { LOAD_MUTEX };
+  if (LOADED_SERIES.has_value()) {
+    throw std::runtime_error { "The ELP/MPP02 series are already loaded." };
+  }
+  LOADED_SERIES.emplace(load_binary(path), fit);
+}
+
+/** @brief Return true if the series are loaded. */
+inline auto is_loaded() -> bool {
+  const std::lock_guard lock { LOAD_MUTEX };
+  return LOADED_SERIES.has_value();
+}
+
+/**
+ * @brief Return the registered series.
+ * @throw std::runtime_error If the series are not loaded.
+ */
+inline auto loaded() -> const Series& {
+  if (not LOADED_SERIES.has_value()) {
+    throw std::runtime_error { "The ELP/MPP02 series are not loaded, see astro::elpmpp02::load." };
+  }
+  return *LOADED_SERIES;
+}
+
+/**
+ * @brief Calculate the geometric geocentric position of the Moon, referred to the mean ecliptic and equinox of date.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param threshold The amplitude threshold in arcseconds, see `Series::evaluate`. 0 evaluates all the terms.
+ * @throw std::runtime_error If the series are not loaded.
+ */
+inline auto geometric(const double jde, const double threshold = 0.0) -> EclipticCoord {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  return precess_from_j2000(to_j2000(loaded().evaluate(jc, threshold), jc), jc);
+}
+
+#pragma endregion
+
+} // namespace astro::elpmpp02
@@ -0,0 +1,466 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <bit>
+#include <array>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <format>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <charconv>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+// The coefficients of the lunar theory ELP/MPP02 (Chapront & Francou, 2003), loaded at runtime.
+//
+// The original distribution is six ASCII files: ELP_MAIN.S1, ELP_MAIN.S2 and ELP_MAIN.S3 hold the main problem,
+// ELP_PERT.S1, ELP_PERT.S2 and ELP_PERT.S3 hold the perturbations, of the longitude, the latitude and the distance.
+// They are about 3 MB of text in total, so `convert_elpmpp02` (see src/tools) packs them into a compact binary file
+// once, which `read_binary` loads with no text parsing at all.
+//
+// The raw coefficients are kept here; the corrections of the fitted constants are applied by `Series`, see `elpmpp02.hpp`.
+
+namespace astro::elpmpp02 {
+
+#pragma region Raw Coefficients
+
+/** @brief The number of variables, i.e. the longitude, the latitude and the distance. */
+constexpr std::size_t VARIABLES = 3;
+
+/** @brief The number of the powers of t of the perturbations, i.e. t^0 to t^3. */
+constexpr std::size_t POWERS = 4;
+
+/** @brief The number of the multipliers of a perturbation term: 4 Delaunay arguments, 8 planets and ζ. */
+constexpr std::size_t PERTURBATION_ARGUMENTS = 13;
+
+
+/** 
+ * @struct A term of the main problem, A·sin(θ) for the longitude and the latitude, A·cos(θ) for the distance.
+ * @note θ = i1·D + i2·F + i3·l + i4·l', where D, F, l and l' are the Delaunay arguments.
+ */
+struct MainTerm {
+  std::array<int8_t, 4> multipliers; // i1 to i4.
+  double A;                          // In arcseconds for the longitude and the latitude, in KM for the distance.
+  std::array<double, 5> B;           // The derivatives of A with respect to the fitted constants, B1 to B5.
+};
+
+/**
+ * @struct A term of the perturbations, S·sin(θ) + C·cos(θ).
+ * @note θ = Σ i_k·φ_k, with the 4 Delaunay arguments, the mean longitudes of the 8 planets from Mercury to Neptune, and ζ.
+ */
+struct PerturbationTerm {
+  std::array<int8_t, PERTURBATION_ARGUMENTS> multipliers;
+  double S;
+  double C;
+};
+
+/** @struct The coefficients of ELP/MPP02, as in the distribution files. */
+struct Coefficients {
+  std::array<std::vector<MainTerm>, VARIABLES> main;                                  // By variable.
+  std::array<std::array<std::vector<PerturbationTerm>, POWERS>, VARIABLES> perturbation; // By variable, then by the power of t.
+
+  /** @brief Return the total number of terms. */
+  [[nodiscard]] auto term_count() const -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+      count += main.at(variable).size();
+      for (const auto& terms : perturbation.at(variable)) {
+        count += terms.size();
+      }
+    }
+    return count;
+  }
+};
+
+#pragma endregion
+
+
+#pragma region ASCII Files
+
+/** @brief Return the names of the distribution files of the main problem and of the perturbations of a variable. */
+inline auto file_names(const std::size_t variable) -> std::array<std::string, 2> {
+  return { std::format("ELP_MAIN.S{}", variable + 1), std::format("ELP_PERT.S{}", variable + 1) };
+}
+
+
+namespace detail {
+
+/** @class A line-by-line reader of a distribution file, which reports the line number of malformed lines. */
+class LineReader {
+public:
+  explicit LineReader(std::istream& in) : _in { in } {}
+
+  /** @brief Read the next non-blank line. */
+  auto next() -> std::string_view {
+    while (std::getline(_in, _line)) {
+      ++_line_number;
+      if (_line.find_first_not_of(" \t\r") != std::string::npos) {
+        return _line;
+      }
+    }
+    fail("unexpected end of file");
+    return "";
+  }
+
+  /** @brief Throw for a malformed line. */
+  [[noreturn]] void fail(const std::string_view reason) const {
+    throw std::runtime_error { std::format("Malformed ELP/MPP02 file at line {}: {}", _line_number, reason) };
+  }
+
+  /** @brief Return the field of the current line at the given columns, without the surrounding blanks. */
+  [[nodiscard]] auto field(const std::size_t begin, const std::size_t width) const -> std::string_view {
+    if (begin >= _line.size()) {
+      fail(std::format("missing the field at column {}", begin + 1));
+    }
+    std::string_view value = std::string_view { _line }.substr(begin, width);
+    value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+    value.remove_suffix(value.size() - std::min(value.find_last_not_of(" \r") + 1, value.size()));
+    return value;
+  }
+
+  /** @brief Parse an integer field. */
+  template <typename T>
+  [[nodiscard]] auto integer(const std::string_view word) const -> T {
+    T value {};
+    const auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+    if (word.empty() or error != std::errc {} or end != word.data() + word.size()) {
+      fail(std::format("invalid integer {}", word));
+    }
+    return value;
+  }
+
+  /** @brief Parse a floating-point field, which may have a FORTRAN exponent, e.g. "0.1234567890123D-04". */
+  [[nodiscard]] auto number(const std::string_view word) const -> double {
+    std::string text { word.starts_with('+') ? word.substr(1) : word };
+    std::ranges::replace(text, 'D', 'E');
+    std::ranges::replace(text, 'd', 'e');
+
+    double value = 0.0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() or error != std::errc {} or end != text.data() + text.size()) {
+      fail(std::format("invalid number {}", word));
+    }
+    return value;
+  }
+
+  /** @brief Return the last integers of a header, e.g. the number of terms. */
+  template <std::size_t N>
+  [[nodiscard]] auto header() const -> std::array<std::size_t, N> {
+    // A header starts with its title, e.g. " MAIN PROBLEM. LONGITUDE", unlike a term.
+    const std::size_t title = _line.find_first_not_of(' ');
+    if (title == std::string::npos or std::isalpha(static_cast<unsigned char>(_line[title])) == 0) {
+      fail("expected a header");
+    }
+
+    std::vector<std::string_view> words;
+    for (std::size_t begin = 0; begin < _line.size();) {
+      const std::size_t first = _line.find_first_not_of(" \r", begin);
+      if (first == std::string::npos) {
+        break;
+      }
+      const std::size_t last = std::min(_line.find_first_of(" \r", first), _line.size());
+      words.emplace_back(std::string_view { _line }.substr(first, last - first));
+      begin = last;
+    }
+    if (words.size() < N) {
+      fail("expected a header");
+    }
+
+    std::array<std::size_t, N> values {};
+    for (std::size_t i = 0; i < N; ++i) {
+      values.at(i) = integer<std::size_t>(words[words.size() - N + i]);
+    }
+    return values;
+  }
+
+  /** @brief Parse a multiplier, which must fit in `int8_t`. */
+  [[nodiscard]] auto multiplier(const std::size_t begin, const std::size_t width) const -> int8_t {
+    return integer<int8_t>(field(begin, width));
+  }
+
+private:
+  std::istream& _in;
+  std::string _line;
+  std::size_t _line_number { 0 };
+};
+
+} // namespace detail
+
+
+/**
+ * @brief Parse a file of the main problem, i.e. ELP_MAIN.S1, ELP_MAIN.S2 or ELP_MAIN.S3.
+ * @param in The stream of the file.
+ * @return The terms, in the order of the file.
+ * @throw std::runtime_error If the file is malformed.
+ * @note A header line ends with the number of terms. Each term is in the FORTRAN format 4i3,2x,f13.5,5f12.2.
+ */
+inline auto parse_main(std::istream& in) -> std::vector<MainTerm> {
+  detail::LineReader reader { in };
+  reader.next();
+  const auto [count] = reader.header<1>();
+
+  std::vector<MainTerm> terms(count);
+  for (MainTerm& term : terms) {
+    reader.next();
+    for (std::size_t i = 0; i < term.multipliers.size(); ++i) {
+      term.multipliers.at(i) = reader.multiplier(3 * i, 3);
+    }
+    term.A = reader.number(reader.field(14, 13));
+    for (std::size_t i = 0; i < term.B.size(); ++i) {
+      term.B.at(i) = reader.number(reader.field(27 + 12 * i, 12));
+    }
+  }
+  return terms;
+}
+
+/**
+ * @brief Parse a file of the perturbations, i.e. ELP_PERT.S1, ELP_PERT.S2 or ELP_PERT.S3.
+ * @param in The stream of the file.
+ * @return The terms, by the power of t.
+ * @throw std::runtime_error If the file is malformed, or the powers are not 0 to 3 in order.
+ * @note Each block starts with a header which ends with the number of terms and the power of t.
+ *       Each term is in the FORTRAN format i5,2d20.13,13i3.
+ */
+inline auto parse_perturbation(std::istream& in) -> std::array<std::vector<PerturbationTerm>, POWERS> {
+  detail::LineReader reader { in };
+
+  std::array<std::vector<PerturbationTerm>, POWERS> blocks;
+  for (std::size_t power = 0; power < POWERS; ++power) {
+    reader.next();
+    const auto [count, declared_power] = reader.header<2>();
+    if (declared_power != power) {
+      reader.fail(std::format("expected the block of t^{}, but got t^{}", power, declared_power));
+    }
+
+    auto& terms = blocks.at(power);
+    terms.resize(count);
+    for (PerturbationTerm& term : terms) {
+      reader.next();
+      term.S = reader.number(reader.field(5, 20));
+      term.C = reader.number(reader.field(25, 20));
+      for (std::size_t i = 0; i < PERTURBATION_ARGUMENTS; ++i) {
+        term.multipliers.at(i) = reader.multiplier(45 + 3 * i, 3);
+      }
+    }
+  }
+  return blocks;
+}
+
+/**
+ * @brief Load the six distribution files.
+ * @param directory The directory of ELP_MAIN.S1, ..., ELP_PERT.S3.
+ * @throw std::runtime_error If a file cannot be read, or is malformed.
+ */
+inline auto load_ascii(const std::filesystem::path& directory) -> Coefficients {
+  const auto open = [](const std::filesystem::path& path) {
+    std::ifstream in { path };
+    if (not in) {
+      throw std::runtime_error { std::format("Failed to open {}", path.string()) };
+    }
+    return in;
+  };
+
+  Coefficients coefficients;
+  for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+    const auto [main_name, perturbation_name] = file_names(variable);
+
+    std::ifstream main = open(directory / main_name);
+    coefficients.main.at(variable) = parse_main(main);
+
+    std::ifstream perturbation = open(directory / perturbation_name);
+    coefficients.perturbation.at(variable) = parse_perturbation(perturbation);
+  }
+  return coefficients;
+}
+
+#pragma endregion
+
+
+#pragma region Binary File
+
+// The binary file is little-endian, with no padding:
+// 1. The magic "ELPMPP02", and the format version, as uint32.
+// 2. For each variable, the number of main problem terms as uint32, then the terms: 4 int8 multipliers, A and B1 to B5 as float64.
+// 3. For each variable and each power of t, the number of perturbation terms as uint32, then the terms: 13 int8 multipliers, S and C as float64.
+// So a main problem term takes 52 bytes, and a perturbation term 29 bytes.
+
+/** @brief The magic of the binary file. */
+constexpr std::string_view BINARY_MAGIC = "ELPMPP02";
+
+/** @brief The version of the format of the binary file. */
+constexpr uint32_t BINARY_VERSION = 1;
+
+
+namespace detail {
+
+/** @brief Write an integer or a float64, in little-endian order. */
+template <typename T>
+inline void write_le(std::ostream& out, const T value) {
+  using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint8_t>>;
+  auto bits = std::bit_cast<Bits>(value);
+  if constexpr (std::endian::native == std::endian::big) {
+    bits = std::byteswap(bits);
+  }
+  out.write(reinterpret_cast<const char*>(&bits), sizeof(bits)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+/** @brief Read an integer or a float64, in little-endian order. */
+template <typename T>
+inline auto read_le(std::istream& in) -> T {
+  using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint8_t>>;
+  Bits bits {};
+  if (not in.read(reinterpret_cast<char*>(&bits), sizeof(bits))) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    throw std::runtime_error { "Malformed ELP/MPP02 binary file: unexpected end of file" };
+  }
+  if constexpr (std::endian::native == std::endian::big) {
+    bits = std::byteswap(bits);
+  }
+  return std::bit_cast<T>(bits);
+}
+
+/** @brief Read a count, which must not exceed what the rest of the file can hold. */
+inline auto read_count(std::istream& in) -> std::size_t {
+  constexpr uint32_t MAX_COUNT = 1U << 20U; // Far more than the ~35,000 terms of ELP/MPP02.
+  const auto count = read_le<uint32_t>(in);
+  if (count > MAX_COUNT) {
+    throw std::runtime_error { std::format("Malformed ELP/MPP02 binary file: {} terms in a series", count) };
+  }
+  return count;
+}
+
+} // namespace detail
+
+
+/**
+ * @brief Write the coefficients to the compact binary file.
+ * @param out The binary stream.
+ * @param coefficients The coefficients.
+ */
+inline void write_binary(std::ostream& out, const Coefficients& coefficients) {
+  using detail::write_le;
+
+  out.write(BINARY_MAGIC.data(), static_cast<std::streamsize>(BINARY_MAGIC.size()));
+  write_le(out, BINARY_VERSION);
+
+  for (const auto& terms : coefficients.main) {
+    write_le(out, static_cast<uint32_t>(terms.size()));
+    for (const MainTerm& term : terms) {
+      for (const int8_t multiplier : term.multipliers) {
+        write_le(out, multiplier);
+      }
+      write_le(out, term.A);
+      for (const double B : term.B) {
+        write_le(out, B);
+      }
+    }
+  }
+
+  for (const auto& blocks : coefficients.perturbation) {
+    for (const auto& terms : blocks) {
+      write_le(out, static_cast<uint32_t>(terms.size()));
+      for (const PerturbationTerm& term : terms) {
+        for (const int8_t multiplier : term.multipliers) {
+          write_le(out, multiplier);
+        }
+        write_le(out, term.S);
+        write_le(out, term.C);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Read the coefficients from the compact binary file.
+ * @param in The binary stream.
+ * @throw std::runtime_error If the file is not an ELP/MPP02 binary file of this version, or is truncated.
+ */
+inline auto read_binary(std::istream& in) -> Coefficients {
+  using detail::read_le;
+  using detail::read_count;
+
+  std::array<char, BINARY_MAGIC.size()> magic {};
+  if (not in.read(magic.data(), magic.size()) or std::string_view { magic.data(), magic.size() } != BINARY_MAGIC) {
+    throw std::runtime_error { "Not an ELP/MPP02 binary file" };
+  }
+  if (const auto version = read_le<uint32_t>(in); version != BINARY_VERSION) {
+    throw std::runtime_error { std::format("Unsupported ELP/MPP02 binary file version {}", version) };
+  }
+
+  Coefficients coefficients;
+  for (auto& terms : coefficients.main) {
+    terms.resize(read_count(in));
+    for (MainTerm& term : terms) {
+      for (int8_t& multiplier : term.multipliers) {
+        multiplier = read_le<int8_t>(in);
+      }
+      term.A = read_le<double>(in);
+      for (double& B : term.B) {
+        B = read_le<double>(in);
+      }
+    }
+  }
+
+  for (auto& blocks : coefficients.perturbation) {
+    for (auto& terms : blocks) {
+      terms.resize(read_count(in));
+      for (PerturbationTerm& term : terms) {
+        for (int8_t& multiplier : term.multipliers) {
+          multiplier = read_le<int8_t>(in);
+        }
+        term.S = read_le<double>(in);
+        term.C = read_le<double>(in);
+      }
+    }
+  }
+
+  if (in.peek() != std::istream::traits_type::eof()) {
+    throw std::runtime_error { "Malformed ELP/MPP02 binary file: trailing bytes" };
+  }
+  return coefficients;
+}
+
+/**
+ * @brief Load the coefficients from the compact binary file.
+ * @param path The path to the file, written by `write_binary`, e.g. with `convert_elpmpp02`.
+ * @throw std::runtime_error If the file cannot be read, or is malformed.
+ */
+inline auto load_binary(const std::filesystem::path& path) -> Coefficients {
+  std::ifstream in { path, std::ios::binary };
+  if (not in) {
+    throw std::runtime_error { std::format("Failed to open {}", path.string()) };
+  }
+  return read_binary(in);
+}
+
+#pragma endregion
+
+} // namespace astro::elpmpp02
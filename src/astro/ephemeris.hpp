@@ -0,0 +1,503 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <bit>
+#include <span>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numbers>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define ASTRO_EPHEMERIS_MMAP 1
+#endif
+
+#include "toolbox.hpp"
+
+namespace astro::ephemeris {
+
+// A JPL-DE-style precomputed ephemeris: the time range is split into granules of equal length,
+// and in every granule, each of λ, β and r is fitted with a Chebyshev series.
+// A lookup is an O(1) granule index, plus a Clenshaw sum per component.
+
+using astro::toolbox::Angle;
+using astro::toolbox::AngleUnit::DEG;
+using astro::toolbox::Distance;
+using astro::toolbox::DistanceUnit::AU;
+using astro::toolbox::SphericalCoordinate;
+
+#pragma region Chebyshev Series
+
+/**
+ * @brief Return the i-th of the `n` Chebyshev nodes (of the first kind) on [-1, 1], i.e. cos(π·(i + 0.5) / n).
+ * @note The nodes are in decreasing order.
+ */
+inline auto chebyshev_node(const std::size_t i, const std::size_t n) -> double {
+  return std::cos(std::numbers::pi * (static_cast<double>(i) + 0.5) / static_cast<double>(n));
+}
+
+/**
+ * @brief Fit a Chebyshev series by interpolating the values at the Chebyshev nodes.
+ * @param values The values at the `n` Chebyshev nodes, i.e. `values[i] = f(chebyshev_node(i, n))`.
+ * @param count The number of coefficients to return, no more than `values.size()`.
+ * @return The first `count` coefficients of the interpolating series.
+ */
+inline auto chebyshev_fit(const std::span<const double> values, const std::size_t count) -> std::vector<double> {
+  const std::size_t n = values.size();
+  std::vector<double> coeffs(count, 0.0);
+  for (std::size_t k = 0; k < count; ++k) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      sum += values[i] * std::cos(std::numbers::pi * static_cast<double>(k) * (static_cast<double>(i) + 0.5) / static_cast<double>(n));
+    }
+    coeffs[k] = 2.0 * sum / static_cast<double>(n);
+  }
+
+  if (count > 0) {
+    coeffs[0] /= 2.0;
+  }
+  return coeffs;
+}
+
+/**
+ * @brief Evaluate a Chebyshev series with Clenshaw's algorithm.
+ * @param coeffs The coefficients of the series.
+ * @param x The point to evaluate at, in [-1, 1].
+ * @return The sum of `coeffs[k] * T_k(x)`.
+ */
+inline auto clenshaw(const std::span<const double> coeffs, const double x) -> double {
+  if (coeffs.empty()) {
+    return 0.0;
+  }
+
+  double b1 = 0.0;
+  double b2 = 0.0;
+  for (std::size_t k = coeffs.size() - 1; k >= 1; --k) {
+    const double b0 = 2.0 * x * b1 - b2 + coeffs[k];
+    b2 = b1;
+    b1 = b0;
+  }
+  return x * b1 - b2 + coeffs[0];
+}
+
+#pragma endregion
+
+
+#pragma region File Format
+
+// The file is little-endian, and consists of a 64-byte `Header` followed by the payload.
+// The payload holds `granule_count` granules. Each granule holds `counts[0]` coefficients for λ (degrees),
+// then `counts[1]` for β (degrees), then `counts[2]` for r (AU), all as IEEE-754 doubles.
+//
+// Within a granule, λ is continuous (i.e. not normalized), so that it can be fitted. It's normalized on lookup.
+
+/** @brief The magic bytes at the start of an ephemeris file. */
+constexpr std::array<char, 8> MAGIC { 'C', 'C', 'E', 'P', 'H', 'E', 'M', '\0' };
+
+/** @brief The version of the file format. Files of other versions are rejected. */
+constexpr uint32_t VERSION = 1;
+
+/** @struct The header of an ephemeris file. */
+struct Header {
+  std::array<char, 8>     magic;         // `MAGIC`
+  uint32_t                version;       // `VERSION`
+  std::array<uint32_t, 3> counts;        // The number of coefficients of λ, β and r, in every granule.
+  double                  start_jde;     // The JDE at which the first granule starts.
+  double                  granule_days;  // The length of every granule, in days.
+  uint64_t                granule_count; // The number of granules.
+  uint64_t                checksum;      // The FNV-1a hash of the payload.
+  uint64_t                reserved;      // Always 0.
+};
+
+static_assert(sizeof(Header) == 64);
+static_assert(std::is_trivially_copyable_v<Header>);
+
+
+/** @brief Return the FNV-1a hash of the given bytes. */
+inline auto fnv1a(const std::span<const std::byte> bytes, uint64_t hash = 0xcbf29ce484222325) -> uint64_t {
+  for (const std::byte byte : bytes) {
+    hash ^= static_cast<uint64_t>(byte);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+/** @brief Convert between the native byte order and little-endian. The conversion is its own inverse. */
+template <typename T>
+inline auto to_little_endian(const T value) -> T {
+  if constexpr (std::endian::native == std::endian::little or sizeof(T) == 1) {
+    return value;
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint16_t>>;
+    return std::bit_cast<T>(std::byteswap(std::bit_cast<Bits>(value)));
+  }
+}
+
+/** @brief Convert all the fields of the header between the native byte order and little-endian. */
+inline auto to_little_endian(Header header) -> Header {
+  header.version = to_little_endian(header.version);
+  for (auto& count : header.counts) {
+    count = to_little_endian(count);
+  }
+  header.start_jde     = to_little_endian(header.start_jde);
+  header.granule_days  = to_little_endian(header.granule_days);
+  header.granule_count = to_little_endian(header.granule_count);
+  header.checksum      = to_little_endian(header.checksum);
+  header.reserved      = to_little_endian(header.reserved);
+  return header;
+}
+
+
+/**
+ * @class The read-only content of a file.
+ * @details On POSIX systems, the file is memory-mapped. Otherwise, or if the mapping fails, the file is read into memory.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Map or read the file.
+   * @param path The path of the file.
+   * @throw std::runtime_error If the file cannot be read.
+   */
+  explicit MappedFile(const std::string& path) {
+#ifdef ASTRO_EPHEMERIS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fd >= 0) {
+      struct stat st {};
+      if (::fstat(fd, &st) == 0 and st.st_size > 0) {
+        _mapping_size = static_cast<std::size_t>(st.st_size);
+        void* mapping = ::mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+          _mapping = mapping;
+        }
+      }
+      ::close(fd);
+      if (_mapping != nullptr) {
+        return;
+      }
+    }
+#endif
+
+    std::ifstream file { path, std::ios::binary };
+    if (!file) {
+      throw std::runtime_error { "Failed to open the file: " + path };
+    }
+    _bytes.assign(std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {});
+  }
+
+  ~MappedFile() {
+    close();
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+  auto operator=(MappedFile&&) -> MappedFile& = delete;
+
+  /** @brief Return true if the file is memory-mapped, in which case `bytes` starts at a page boundary. */
+  [[nodiscard]] auto is_mapped() const -> bool {
+    return _mapping != nullptr;
+  }
+
+  /** @brief Return the content of the file. Empty after `close`. */
+  [[nodiscard]] auto bytes() const -> std::span<const std::byte> {
+    if (is_mapped()) {
+      return { static_cast<const std::byte*>(_mapping), _mapping_size };
+    }
+    return std::as_bytes(std::span { _bytes });
+  }
+
+  /** @brief Release the content, once it's no longer needed. */
+  void close() {
+#ifdef ASTRO_EPHEMERIS_MMAP
+    if (_mapping != nullptr) {
+      ::munmap(_mapping, _mapping_size);
+    }
+#endif
+    _mapping = nullptr;
+    _mapping_size = 0;
+    _bytes = {};
+  }
+
+private:
+  void* _mapping { nullptr };
+  std::size_t _mapping_size { 0 };
+  std::vector<char> _bytes; // The file content, when it's not memory-mapped.
+};
+
+#pragma endregion
+
+
+#pragma region Generation
+
+/** @struct The options of the generation of an ephemeris. */
+struct GenerateOptions {
+  /** @brief The length of every granule, in days. */
+  double granule_days = 32.0;
+
+  /** 
+   * @brief The number of Chebyshev coefficients of λ, β and r, in every granule. 
+   * @note For the Sun, the defaults keep the fits within 1e-9° for λ and β, and 1e-10 AU for r, of the analytic model.
+   */
+  std::array<uint32_t, 3> counts { 28, 20, 20 };
+};
+
+/** @brief A function that evaluates the modelled positions on many JDEs at once. */
+using Sampler = std::function<std::vector<SphericalCoordinate>(std::span<const double>)>;
+
+
+/**
+ * @brief Fit the model and write the ephemeris file.
+ * @param path The path of the file to write.
+ * @param start_jde The start of the coverage.
+ * @param end_jde The end of the coverage. Rounded up to a whole number of granules.
+ * @param sampler The model to fit.
+ * @param options The granule length and the numbers of coefficients.
+ * @throw std::invalid_argument If the range or the options are invalid.
+ * @throw std::runtime_error If the file cannot be written.
+ */
+inline void generate(
+  const std::string& path, 
+  const double start_jde, 
+  const double end_jde, 
+  const Sampler& sampler, 
+  const GenerateOptions& options = {}
+) {
+  if (!(start_jde < end_jde) or !(options.granule_days > 0.0)) {
+    throw std::invalid_argument { "Invalid range or granule length." };
+  }
+  if (std::ranges::any_of(options.counts, [](const uint32_t count) { return count == 0; })) {
+    throw std::invalid_argument { "The numbers of coefficients must be positive." };
+  }
+
+  const auto granule_count = static_cast<uint64_t>(std::ceil((end_jde - start_jde) / options.granule_days));
+  const std::size_t nodes = *std::ranges::max_element(options.counts);
+
+  std::vector<double> payload;
+  payload.reserve(granule_count * (options.counts[0] + options.counts[1] + options.counts[2]));
+
+  std::vector<double> jdes(nodes);
+  std::array<std::vector<double>, 3> values;
+  for (auto& v : values) {
+    v.resize(nodes);
+  }
+
+  for (uint64_t g = 0; g < granule_count; ++g) {
+    const double granule_start = start_jde + static_cast<double>(g) * options.granule_days;
+    for (std::size_t i = 0; i < nodes; ++i) {
+      jdes[i] = granule_start + (chebyshev_node(i, nodes) + 1.0) / 2.0 * options.granule_days;
+    }
+
+    const auto coords = sampler(jdes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+      // Unwrap λ, so that it's continuous in the granule.
+      const double λ = coords[i].λ.deg();
+      values[0][i] = i == 0 ? λ : values[0][0] + astro::toolbox::normalize_pm180(λ - values[0][0]);
+      values[1][i] = coords[i].β.deg();
+      values[2][i] = coords[i].r.au();
+    }
+
+    for (std::size_t c = 0; c < 3; ++c) {
+      const auto coeffs = chebyshev_fit(values[c], options.counts[c]);
+      payload.insert(payload.end(), coeffs.begin(), coeffs.end());
+    }
+  }
+
+  for (double& value : payload) {
+    value = to_little_endian(value);
+  }
+  const auto bytes = std::as_bytes(std::span { payload });
+
+  const Header header {
+    .magic = MAGIC,
+    .version = VERSION,
+    .counts = options.counts,
+    .start_jde = start_jde,
+    .granule_days = options.granule_days,
+    .granule_count = granule_count,
+    .checksum = fnv1a(bytes),
+    .reserved = 0,
+  };
+  const Header le_header = to_little_endian(header);
+
+  std::ofstream file { path, std::ios::binary | std::ios::trunc };
+  file.write(reinterpret_cast<const char*>(&le_header), sizeof(Header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!file) {
+    throw std::runtime_error { "Failed to write the ephemeris file: " + path };
+  }
+}
+
+#pragma endregion
+
+
+#pragma region Lookup
+
+/**
+ * @class A read-only ephemeris file. 
+ * @details On POSIX systems with little-endian CPUs, the file is memory-mapped, and the coefficients are used in place.
+ *          Otherwise, the file is read (and byte-swapped if necessary) into memory.
+ */
+class Ephemeris {
+public:
+  /**
+   * @brief Open and validate an ephemeris file.
+   * @param path The path of the file.
+   * @throw std::runtime_error If the file cannot be read, or is not a valid ephemeris file of `VERSION`, 
+   *                           or its size or checksum does not match its header.
+   */
+  explicit Ephemeris(const std::string& path) : _file { path } {
+    const auto bytes = _file.bytes();
+    if (bytes.size() < sizeof(Header)) {
+      throw std::runtime_error { "The ephemeris file is truncated: " + path };
+    }
+
+    std::memcpy(&_header, bytes.data(), sizeof(Header));
+    _header = to_little_endian(_header);
+    if (_header.magic != MAGIC) {
+      throw std::runtime_error { "Not an ephemeris file: " + path };
+    }
+    if (_header.version != VERSION) {
+      throw std::runtime_error { "Unsupported ephemeris file version " + std::to_string(_header.version) + ": " + path };
+    }
+    if (!(_header.granule_days > 0.0) or _header.granule_count == 0 
+        or std::ranges::any_of(_header.counts, [](const uint32_t count) { return count == 0; })) {
+      throw std::runtime_error { "Invalid ephemeris file header: " + path };
+    }
+
+    _stride = std::size_t { _header.counts[0] } + _header.counts[1] + _header.counts[2];
+    if (_stride == 0) {
+      throw std::runtime_error { "Invalid ephemeris file header: " + path };
+    }
+
+    // Divided rather than multiplied, since a crafted granule count can wrap `granule_count * _stride * sizeof(double)` around.
+    const auto payload = bytes.subspan(sizeof(Header));
+    const std::size_t payload_doubles = payload.size() / sizeof(double);
+    if (payload.size() % sizeof(double) != 0 or payload_doubles % _stride != 0 
+        or _header.granule_count != payload_doubles / _stride) {
+      throw std::runtime_error { "The size of the ephemeris file does not match its header: " + path };
+    }
+    if (fnv1a(payload) != _header.checksum) {
+      throw std::runtime_error { "The checksum of the ephemeris file does not match: " + path };
+    }
+
+    if constexpr (std::endian::native == std::endian::little) {
+      if (_file.is_mapped()) {
+        // Zero-copy: the payload starts at offset 64 of a page-aligned mapping, so it's aligned for doubles.
+        _coeffs = { reinterpret_cast<const double*>(payload.data()), payload.size() / sizeof(double) }; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return;
+      }
+    }
+
+    _owned.resize(payload.size() / sizeof(double));
+    std::memcpy(_owned.data(), payload.data(), payload.size());
+    for (double& value : _owned) {
+      value = to_little_endian(value);
+    }
+    _coeffs = _owned;
+
+    // The raw bytes are no longer needed.
+    _file.close();
+  }
+
+  ~Ephemeris() = default;
+
+  Ephemeris(const Ephemeris&) = delete;
+  Ephemeris(Ephemeris&&) = delete;
+  auto operator=(const Ephemeris&) -> Ephemeris& = delete;
+  auto operator=(Ephemeris&&) -> Ephemeris& = delete;
+
+  /** @brief Return the header of the file. */
+  [[nodiscard]] auto header() const -> const Header& {
+    return _header;
+  }
+
+  /** @brief Return the start of the coverage, inclusive. */
+  [[nodiscard]] auto start_jde() const -> double {
+    return _header.start_jde;
+  }
+
+  /** @brief Return the end of the coverage, exclusive. */
+  [[nodiscard]] auto end_jde() const -> double {
+    return _header.start_jde + static_cast<double>(_header.granule_count) * _header.granule_days;
+  }
+
+  /** @brief Return true if the given JDE is covered by the file. */
+  [[nodiscard]] auto covers(const double jde) const -> bool {
+    return start_jde() <= jde and jde < end_jde();
+  }
+
+  /**
+   * @brief Look up the position at the given JDE.
+   * @param jde The julian ephemeris day number.
+   * @return The position, with λ normalized to [0, 360).
+   * @throw std::out_of_range If the JDE is not covered by the file.
+   */
+  [[nodiscard]] auto lookup(const double jde) const -> SphericalCoordinate {
+    if (!covers(jde)) {
+      throw std::out_of_range { "The JDE is not covered by the ephemeris." };
+    }
+
+    const double offset = (jde - _header.start_jde) / _header.granule_days;
+    const auto index = std::min(static_cast<uint64_t>(offset), _header.granule_count - 1);
+    const double x = 2.0 * (offset - static_cast<double>(index)) - 1.0;
+
+    const auto granule = _coeffs.subspan(index * _stride, _stride);
+    const auto λ = granule.first(_header.counts[0]);
+    const auto β = granule.subspan(_header.counts[0], _header.counts[1]);
+    const auto r = granule.last(_header.counts[2]);
+
+    return {
+      .λ = Angle<DEG>(clenshaw(λ, x)).normalize(),
+      .β = Angle<DEG>(clenshaw(β, x)),
+      .r = Distance<AU>(clenshaw(r, x)),
+    };
+  }
+
+private:
+  Header _header {};
+  std::size_t _stride { 0 };
+  std::span<const double> _coeffs;
+
+  MappedFile _file;
+  std::vector<double> _owned; // The coefficients, when they cannot be used in place.
+};
+
+#pragma endregion
+
+} // namespace astro::ephemeris
@@ -0,0 +1,78 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "toolbox.hpp"
+#include "julian_day.hpp"
+#include "earth.hpp"
+
+
+namespace astro::epoch {
+
+using astro::toolbox::Angle;
+using astro::toolbox::AngleUnit::DEG;
+using astro::earth::nutation::Model;
+using astro::earth::nutation::Nutation;
+
+
+/**
+ * @struct The quantities of an epoch shared by the Sun, the Moon, the sidereal time and the coordinate transforms.
+ * @details Computing them once per epoch saves e.g. the second nutation series of `new_moon::longitude_diff`, 
+ *          where the Sun and the Moon are corrected by the same Δψ. 
+ */
+struct EpochContext {
+  double jde;               // The julian ephemeris day number, which is based on TT.
+  double jc;                // The julian century since J2000.
+  Model model;              // The nutation model of `nutation` and `ε`.
+  Nutation nutation;        // The nutation in longitude (Δψ) and in obliquity (Δε).
+  Angle<DEG> ε0;            // The mean obliquity of the ecliptic.
+  Angle<DEG> ε;             // The true obliquity of the ecliptic, i.e. ε₀ + Δε.
+};
+
+
+/**
+ * @brief Compute the shared quantities of an epoch.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param model The nutation model to use. Defaults to `nutation::Model::IAU_1980`.
+ * @return The context, with the same values as the standalone functions return at `jde`.
+ */
+inline auto make_context(
+  const double jde, 
+  const Model model = Model::IAU_1980
+) -> EpochContext {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  const Nutation nutation = astro::earth::nutation::compute(jde, model);
+  const Angle<DEG> ε0 = astro::earth::obliquity::mean(jde);
+
+  return {
+    .jde       = jde,
+    .jc        = jc,
+    .model     = model,
+    .nutation  = nutation,
+    .ε0        = ε0,
+    .ε         = ε0 + nutation.Δε,
+  };
+}
+
+} // namespace astro::epoch
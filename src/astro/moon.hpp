@@ -23,15 +23,28 @@
 
 #pragma once
 
+#include <span>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "simd.hpp"
 #include "earth.hpp"
+#include "epoch.hpp"
 #include "julian_day.hpp"
 #include "toolbox.hpp"
 #include "elp2000_82b.hpp"
+#include "elpmpp02/elpmpp02.hpp"
 
 
 namespace astro::moon::perturbation {
 
 using astro::elp2000_82b::Context;
+using astro::elp2000_82b::ContextRate;
+using astro::elp2000_82b::ContextVec;
+using astro::toolbox::Angle;
+using astro::toolbox::AngleUnit::RAD;
 
 /**
  * @brief Calculate perturbation of the Moon's geocentric longitude.
@@ -65,6 +78,56 @@ inline auto latitude(const Context& ctx) -> double {
        - 115.0 * std::sin(ctx.Lp.rad() + ctx.Mp.rad());
 }
 
+
+/**
+ * @brief Calculate the time derivatives of the perturbations of the Moon's geocentric longitude and latitude.
+ * @param ctx The context.
+ * @param rate The rates of the arguments of the context.
+ * @return The derivatives of `longitude` and `latitude`. Unit is 0.000001 degrees per julian century.
+ */
+inline auto rates(const Context& ctx, const ContextRate& rate) -> std::pair<double, double> {
+  const auto cos_rate = [](const Angle<RAD>& angle, const double deg_per_jc) {
+    return std::cos(angle.rad()) * deg_per_jc / toolbox::DEG_PER_RAD;
+  };
+  const Angle<RAD> Lp_F  { ctx.Lp.rad() - ctx.F.rad() };
+  const Angle<RAD> A1_F  { ctx.A1.rad() - ctx.F.rad() };
+  const Angle<RAD> A1F   { ctx.A1.rad() + ctx.F.rad() };
+  const Angle<RAD> Lp_Mp { ctx.Lp.rad() - ctx.Mp.rad() };
+  const Angle<RAD> LpMp  { ctx.Lp.rad() + ctx.Mp.rad() };
+
+  const double longitude = 3958.0 * cos_rate(ctx.A1, rate.A1)
+                         + 1962.0 * cos_rate(Lp_F, rate.Lp - rate.F)
+                         + 318.0 * cos_rate(ctx.A2, rate.A2);
+  const double latitude = -2235.0 * cos_rate(ctx.Lp, rate.Lp)
+                        + 382.0 * cos_rate(ctx.A3, rate.A3)
+                        + 175.0 * cos_rate(A1_F, rate.A1 - rate.F)
+                        + 175.0 * cos_rate(A1F, rate.A1 + rate.F)
+                        + 127.0 * cos_rate(Lp_Mp, rate.Lp - rate.Mp)
+                        - 115.0 * cos_rate(LpMp, rate.Lp + rate.Mp);
+  return { longitude, latitude };
+}
+
+
+/** @brief Vector version of `longitude`, for `simd::LANES` epochs at a time. Unit is 0.000001 degrees. */
+inline auto longitude(const ContextVec& ctx) -> simd::VecD {
+  const auto sin = [](const simd::VecD& deg) { return simd::sin(deg / toolbox::DEG_PER_RAD); };
+  return 3958.0 * sin(ctx.A1) 
+       + 1962.0 * sin(ctx.Lp - ctx.F) 
+       + 318.0 * sin(ctx.A2);
+}
+
+
+/** @brief Vector version of `latitude`, for `simd::LANES` epochs at a time. Unit is 0.000001 degrees. */
+inline auto latitude(const ContextVec& ctx) -> simd::VecD {
+  const auto sin = [](const simd::VecD& deg) { return simd::sin(deg / toolbox::DEG_PER_RAD); };
+  return -2235.0 * sin(ctx.Lp)
+       + 382.0 * sin(ctx.A3)
+       + 175.0 * sin(ctx.A1 - ctx.F)
+       + 175.0 * sin(ctx.A1 + ctx.F)
+       + 127.0 * sin(ctx.Lp - ctx.Mp)
+       - 115.0 * sin(ctx.Lp + ctx.Mp);
+}
+
 } // namespace astro::moon::perturbation
 
 
@@ -76,25 +139,25 @@ using astro::toolbox::AngleUnit::RAD;
 using astro::toolbox::DistanceUnit::KM;
 using astro::toolbox::Distance;
 using astro::toolbox::SphericalCoordinate;
+using astro::toolbox::SphericalCoordinateWithRate;
 
 using astro::elp2000_82b::evaluate;
+using astro::elp2000_82b::evaluate_harmonic;
+using astro::elp2000_82b::evaluate_harmonic_with_rate;
+using astro::elp2000_82b::Evaluation;
 using astro::elp2000_82b::LON_LAT_SCALING_FACTOR;
 using astro::elp2000_82b::RADIUS_SCALING_FACTOR;
 
 
 /**
- * @brief Calculate the apparent geocentric position of the Moon, using truncated ELP2000-82B.
- * @param jde The julian ephemeris day number, which is based on TT.
- * @return The geocentric ecliptic position of the Moon, calculated using truncated ELP2000-82B.
+ * @brief Correct the evaluated ELP2000-82B to the apparent geocentric position of the Moon.
+ * @param evaluated The ELP2000-82B evaluation.
+ * @param lon_nutation The Earth's nutation in longitude (Δψ), at the JDE of the evaluation.
+ * @return The geocentric ecliptic position of the Moon, considering the perturbation and nutation.
  */
-inline auto apparent(const double jde) -> SphericalCoordinate {
-  const double jc = astro::julian_day::jde_to_jc(jde);
-
-  const auto evaluated = evaluate(jc);
-
+inline auto apparent_from_elp(const Evaluation& evaluated, const Angle<DEG> lon_nutation) -> SphericalCoordinate {
   // Longitude, considering the perturbation and nutation.
   const auto Σl = evaluated.Σl + perturbation::longitude(evaluated.ctx);
-  const auto lon_nutation = astro::earth::nutation::longitude(jde);
   const Angle<DEG> lon = evaluated.ctx.Lp + (Σl / LON_LAT_SCALING_FACTOR) + lon_nutation; 
 
   // Latitude, considering the perturbation.
@@ -112,6 +175,181 @@ inline auto apparent(const double jde) -> SphericalCoordinate {
 }
 
 
+/**
+ * @brief Correct the evaluated ELP2000-82B to the apparent geocentric position of the Moon.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param evaluated The ELP2000-82B evaluation at `jde`.
+ * @return The geocentric ecliptic position of the Moon, considering the perturbation and nutation.
+ */
+inline auto apparent_from_elp(const double jde, const Evaluation& evaluated) -> SphericalCoordinate {
+  return apparent_from_elp(evaluated, astro::earth::nutation::longitude(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon, using truncated ELP2000-82B.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The geocentric ecliptic position of the Moon, calculated using truncated ELP2000-82B.
+ */
+inline auto apparent(const double jde) -> SphericalCoordinate {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+
+  // Evaluated with the harmonic tables, which is much cheaper than a trigonometric function call per term.
+  return apparent_from_elp(jde, evaluate_harmonic(jc));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon, with the nutation interpolated.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param nutation The nutation interpolator, see `astro::earth::nutation::NutationInterpolator`.
+ * @return The same position as `apparent`, within the interpolator's error bound.
+ */
+inline auto apparent(const double jde, const astro::earth::nutation::NutationInterpolator& nutation) -> SphericalCoordinate {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  return apparent_from_elp(evaluate_harmonic(jc), nutation.longitude(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon, with the nutation of a shared epoch context.
+ * @param ctx The context of the epoch, see `astro::epoch::make_context`.
+ * @return The same position as `apparent`, when `ctx` uses the default nutation model.
+ */
+inline auto apparent(const astro::epoch::EpochContext& ctx) -> SphericalCoordinate {
+  return apparent_from_elp(evaluate_harmonic(ctx.jc), ctx.nutation.Δψ);
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon and its time derivatives, with the given nutation.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param nutation The nutation and its rates at `jde`, see `nutation::compute_with_rate`.
+ * @return The same position as `apparent`, and the rates in degrees/day and AU/day.
+ * @details The periodic terms, the perturbations and the polynomial of L' are differentiated in closed form, 
+ *          in the same pass as the position.
+ */
+inline auto apparent_with_rate(
+  const double jde, 
+  const astro::earth::nutation::NutationWithRate& nutation
+) -> SphericalCoordinateWithRate {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  const auto evaluated = evaluate_harmonic_with_rate(jc);
+  const auto [lon_perturbation_rate, lat_perturbation_rate] = perturbation::rates(evaluated.value.ctx, evaluated.ctx_rate);
+  const double nutation_rate = nutation.Δψ_rate;
+
+  // The rates of the sums are per julian century.
+  constexpr double DAYS_PER_JC = 36525.0;
+  const double Σl_rate = evaluated.Σl_rate + lon_perturbation_rate;
+  const double Σb_rate = evaluated.Σb_rate + lat_perturbation_rate;
+
+  return {
+    .coord = apparent_from_elp(evaluated.value, nutation.value.Δψ),
+    .rate = {
+      .λ = (evaluated.ctx_rate.Lp + Σl_rate / LON_LAT_SCALING_FACTOR) / DAYS_PER_JC + nutation_rate,
+      .β = Σb_rate / LON_LAT_SCALING_FACTOR / DAYS_PER_JC,
+      .r = toolbox::km_to_au(evaluated.Σr_rate / RADIUS_SCALING_FACTOR / DAYS_PER_JC),
+    },
+  };
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon and its time derivatives.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The same position as `apparent`, and the rates in degrees/day and AU/day.
+ * @details The nutation and its rate come from one pass, see `nutation::compute_with_rate`.
+ */
+inline auto apparent_with_rate(const double jde) -> SphericalCoordinateWithRate {
+  return apparent_with_rate(jde, astro::earth::nutation::compute_with_rate(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric positions of the Moon for many epochs, `simd::LANES` epochs at a time.
+ * @param jdes The julian ephemeris day numbers, which are based on TT.
+ * @param λ_deg The output longitudes in degrees, normalized to [0, 360). Same size as `jdes`.
+ * @param β_deg The output latitudes in degrees. Same size as `jdes`.
+ * @param r_km The output distances in KM. Same size as `jdes`.
+ * @throws std::invalid_argument If the output spans are not the same size as `jdes`.
+ * @details Agrees with `apparent` up to rounding. The coefficient rows are shared by all the lanes, 
+ *          and the outputs are laid out as structure of arrays.
+ */
+inline auto apparent_batch(
+  const std::span<const double> jdes,
+  const std::span<double> λ_deg,
+  const std::span<double> β_deg,
+  const std::span<double> r_km
+) -> void {
+  if (λ_deg.size() != jdes.size() || β_deg.size() != jdes.size() || r_km.size() != jdes.size()) {
+    throw std::invalid_argument { "The output spans must be the same size as the input span" };
+  }
+
+  using simd::VecD;
+  using simd::LANES;
+
+  for (std::size_t begin = 0; begin < jdes.size(); begin += LANES) {
+    // The last vector is padded by repeating the last epoch.
+    std::array<double, LANES> lanes {};
+    for (std::size_t i = 0; i < LANES; ++i) {
+      lanes[i] = jdes[std::min(begin + i, jdes.size() - 1)];
+    }
+    const VecD jde = simd::load(lanes, 0);
+    const VecD jc  = (jde - astro::julian_day::J2000) / 36525.0;
+
+    const auto ctx = astro::elp2000_82b::create_context(jc);
+    const auto [Σl, Σb, Σr] = evaluate_harmonic(ctx);
+
+    // Longitude, considering the perturbation and nutation.
+    const VecD lon = ctx.Lp + (Σl + perturbation::longitude(ctx)) / LON_LAT_SCALING_FACTOR 
+                   + astro::earth::nutation::longitude(jde);
+
+    // Latitude, considering the perturbation.
+    const VecD lat = (Σb + perturbation::latitude(ctx)) / LON_LAT_SCALING_FACTOR;
+
+    // Distance, in KM.
+    const VecD r = 385000.56 + Σr / RADIUS_SCALING_FACTOR;
+
+    for (std::size_t i = 0; i < LANES && begin + i < jdes.size(); ++i) {
+      λ_deg[begin + i] = toolbox::normalize_deg(lon[i]);
+      β_deg[begin + i] = lat[i];
+      r_km[begin + i]  = r[i];
+    }
+  }
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Moon, using the full ELP/MPP02 series.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param threshold The amplitude threshold in arcseconds, to trade accuracy for speed. 0 evaluates all the terms.
+ * @return The geocentric ecliptic position of the Moon, referred to the true equinox of date.
+ * @throw std::runtime_error If the series are not loaded, see `astro::elpmpp02::load`.
+ * @note ELP/MPP02 is geometric, so the light-time is applied here. Meeus builds it into L' of `apparent` instead.
+ */
+inline auto apparent_elpmpp02(const double jde, const double threshold = 0.0) -> SphericalCoordinate {
+  namespace elpmpp02 = astro::elpmpp02;
+  constexpr double LIGHT_DAYS_PER_KM = 1.0 / (299792.458 * 86400.0);
+
+  // The position at the time the light left the Moon, with the light-time of the mean distance.
+  // The rest of the light-time, at most ±0.1 seconds, is applied with the mean motion of the Moon.
+  const double τ0 = elpmpp02::MEAN_DISTANCE * LIGHT_DAYS_PER_KM;
+  const auto geometric = elpmpp02::geometric(jde - τ0, threshold);
+  const double Δτ = (geometric.r - elpmpp02::MEAN_DISTANCE) * LIGHT_DAYS_PER_KM;
+  const double mean_motion = elpmpp02::loaded().arguments().W1[1] / 36525.0; // In radians per day.
+
+  const Angle<RAD> geometric_lon { geometric.λ - Δτ * mean_motion };
+  const auto lon_nutation = astro::earth::nutation::longitude(jde);
+  const Angle<DEG> lon = Angle<DEG> { geometric_lon } + lon_nutation;
+
+  return {
+    .λ = lon.normalize(),
+    .β = Angle<RAD> { geometric.β },
+    .r = Distance<KM> { geometric.r },
+  };
+}
+
+
 /**
  * @brief Calculate the equatorial horizontal parallax of the Moon.
  * @param coord The geocentric ecliptic position of the Moon.
@@ -23,9 +23,17 @@
 
 #pragma once
 
+#include <cmath>
+#include <array>
+#include <mutex>
+#include <memory>
+#include <string>
 #include <vector>
 #include <format>
-#include <numbers>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
 
 #include "ymd.hpp"
 #include "datetime.hpp"
@@ -33,6 +41,393 @@
 
 #include "sun.hpp"
 #include "moon.hpp"
+#include "solve.hpp"
+#include "new_moon_table.hpp"
+
+
+namespace astro::moon_phase {
+
+// The principal phases of the Moon are the moments when the excess of the apparent longitude of the Moon over 
+// that of the Sun is 0°, 90°, 180° or 270°. In Chinese, these are "朔", "上弦", "望" and "下弦".
+
+/** @enum The principal phases of the Moon, in the order they occur in a lunation. */
+enum class Phase : uint8_t {
+  NEW_MOON,      // 朔, the elongation is 0°.
+  FIRST_QUARTER, // 上弦, the elongation is 90°.
+  FULL_MOON,     // 望, the elongation is 180°.
+  LAST_QUARTER,  // 下弦, the elongation is 270°.
+};
+
+constexpr uint8_t PHASE_COUNT = 4;
+
+
+/**
+ * @brief Get the target elongation of the phase.
+ * @param phase The phase.
+ * @return The excess of the apparent longitude of the Moon over that of the Sun at the phase, in degrees.
+ */
+constexpr auto elongation(const Phase phase) -> double {
+  return 90.0 * static_cast<double>(static_cast<uint8_t>(phase));
+}
+
+
+#pragma region Meeus Phases
+
+namespace meeus {
+
+// The mean phases and the periodic corrections of Astronomical Algorithms, Jean Meeus, 1998, chapter 49.
+// The lunation number `k` is 0 for the new moon of 2000-01-06, and the quarters are at `k + 0.25`, `k + 0.5` and `k + 0.75`.
+
+/** @brief The mean length of the synodic month, in days. */
+constexpr double SYNODIC_MONTH = 29.530588861;
+
+/** @brief The JDE of the mean new moon of the lunation 0. */
+constexpr double EPOCH = 2451550.09766;
+
+/** @struct A periodic correction, `amplitude * E^E * sin(M * Msun + Mp * Mmoon + F * F + Ω * Ω)`. */
+struct Correction {
+  double amplitude; // In days.
+  int8_t E;         // The power of the eccentricity factor of the Earth's orbit.
+  int8_t M, Mp, F, Ω;
+};
+
+using Corrections = std::array<Correction, 25>;
+
+constexpr Corrections NEW_MOON_CORRECTIONS {{
+  { -0.40720, 0,  0,  1,  0, 0 },
+  {  0.17241, 1,  1,  0,  0, 0 },
+  {  0.01608, 0,  0,  2,  0, 0 },
+  {  0.01039, 0,  0,  0,  2, 0 },
+  {  0.00739, 1, -1,  1,  0, 0 },
+  { -0.00514, 1,  1,  1,  0, 0 },
+  {  0.00208, 2,  2,  0,  0, 0 },
+  { -0.00111, 0,  0,  1, -2, 0 },
+  { -0.00057, 0,  0,  1,  2, 0 },
+  {  0.00056, 1,  1,  2,  0, 0 },
+  { -0.00042, 0,  0,  3,  0, 0 },
+  {  0.00042, 1,  1,  0,  2, 0 },
+  {  0.00038, 1,  1,  0, -2, 0 },
+  { -0.00024, 1, -1,  2,  0, 0 },
+  { -0.00017, 0,  0,  0,  0, 1 },
+  { -0.00007, 0,  2,  1,  0, 0 },
+  {  0.00004, 0,  0,  2, -2, 0 },
+  {  0.00004, 0,  3,  0,  0, 0 },
+  {  0.00003, 0,  1,  1, -2, 0 },
+  {  0.00003, 0,  0,  2,  2, 0 },
+  { -0.00003, 0,  1,  1,  2, 0 },
+  {  0.00003, 0, -1,  1,  2, 0 },
+  { -0.00002, 0, -1,  1, -2, 0 },
+  { -0.00002, 0,  1,  3,  0, 0 },
+  {  0.00002, 0,  0,  4,  0, 0 },
+}};
+
+constexpr Corrections FULL_MOON_CORRECTIONS {{
+  { -0.40614, 0,  0,  1,  0, 0 },
+  {  0.17302, 1,  1,  0,  0, 0 },
+  {  0.01614, 0,  0,  2,  0, 0 },
+  {  0.01043, 0,  0,  0,  2, 0 },
+  {  0.00734, 1, -1,  1,  0, 0 },
+  { -0.00515, 1,  1,  1,  0, 0 },
+  {  0.00209, 2,  2,  0,  0, 0 },
+  { -0.00111, 0,  0,  1, -2, 0 },
+  { -0.00057, 0,  0,  1,  2, 0 },
+  {  0.00056, 1,  1,  2,  0, 0 },
+  { -0.00042, 0,  0,  3,  0, 0 },
+  {  0.00042, 1,  1,  0,  2, 0 },
+  {  0.00038, 1,  1,  0, -2, 0 },
+  { -0.00024, 1, -1,  2,  0, 0 },
+  { -0.00017, 0,  0,  0,  0, 1 },
+  { -0.00007, 0,  2,  1,  0, 0 },
+  {  0.00004, 0,  0,  2, -2, 0 },
+  {  0.00004, 0,  3,  0,  0, 0 },
+  {  0.00003, 0,  1,  1, -2, 0 },
+  {  0.00003, 0,  0,  2,  2, 0 },
+  { -0.00003, 0,  1,  1,  2, 0 },
+  {  0.00003, 0, -1,  1,  2, 0 },
+  { -0.00002, 0, -1,  1, -2, 0 },
+  { -0.00002, 0,  1,  3,  0, 0 },
+  {  0.00002, 0,  0,  4,  0, 0 },
+}};
+
+constexpr Corrections QUARTER_CORRECTIONS {{
+  { -0.62801, 0,  0,  1,  0, 0 },
+  {  0.17172, 1,  1,  0,  0, 0 },
+  { -0.01183, 1,  1,  1,  0, 0 },
+  {  0.00862, 0,  0,  2,  0, 0 },
+  {  0.00804, 0,  0,  0,  2, 0 },
+  {  0.00454, 1, -1,  1,  0, 0 },
+  {  0.00204, 2,  2,  0,  0, 0 },
+  { -0.00180, 0,  0,  1, -2, 0 },
+  { -0.00070, 0,  0,  1,  2, 0 },
+  { -0.00040, 0,  0,  3,  0, 0 },
+  { -0.00034, 1, -1,  2,  0, 0 },
+  {  0.00032, 1,  1,  0,  2, 0 },
+  {  0.00032, 1,  1,  0, -2, 0 },
+  { -0.00028, 2,  2,  1,  0, 0 },
+  {  0.00027, 1,  1,  2,  0, 0 },
+  { -0.00017, 0,  0,  0,  0, 1 },
+  { -0.00005, 0, -1,  1, -2, 0 },
+  {  0.00004, 0,  0,  2,  2, 0 },
+  { -0.00004, 0,  1,  1,  2, 0 },
+  {  0.00004, 0, -2,  1,  0, 0 },
+  {  0.00003, 0,  1,  1, -2, 0 },
+  {  0.00003, 0,  3,  0,  0, 0 },
+  {  0.00002, 0,  0,  2, -2, 0 },
+  {  0.00002, 0, -1,  1,  2, 0 },
+  { -0.00002, 0,  1,  3,  0, 0 },
+}};
+
+/** @struct A correction for the planetary arguments, `amplitude * sin(A0 + A1 * k + A2 * T^2)`, with the arguments in degrees. */
+struct PlanetaryCorrection {
+  double amplitude; // In days.
+  double A0, A1, A2;
+};
+
+constexpr std::array<PlanetaryCorrection, 14> PLANETARY_CORRECTIONS {{
+  { 0.000325, 299.77,  0.107408, -0.009173 },
+  { 0.000165, 251.88,  0.016321,  0.0      },
+  { 0.000164, 251.83, 26.651886,  0.0      },
+  { 0.000126, 349.42, 36.412478,  0.0      },
+  { 0.000110,  84.66, 18.206239,  0.0      },
+  { 0.000062, 141.74, 53.303771,  0.0      },
+  { 0.000060, 207.14,  2.453732,  0.0      },
+  { 0.000056, 154.84,  7.306860,  0.0      },
+  { 0.000047,  34.52, 27.261239,  0.0      },
+  { 0.000042, 207.19,  0.121824,  0.0      },
+  { 0.000040, 291.34,  1.844379,  0.0      },
+  { 0.000037, 161.72, 24.198154,  0.0      },
+  { 0.000035, 239.56, 25.513099,  0.0      },
+  { 0.000023, 331.55,  3.592518,  0.0      },
+}};
+
+
+/**
+ * @brief Estimate the moment of a principal phase, i.e. the mean phase with the periodic corrections.
+ * @param lunation The lunation number. 0 is the lunation starting on 2000-01-06, and negative numbers are before it.
+ * @param phase The phase.
+ * @return The JDE of the phase. Compared with the phases solved with VSOP87D and ELP2000-82B, 
+ *         it is within 1 minute over the years 1900 to 2100, and within 3 minutes over the years -2000 to 4000.
+ * @see Astronomical Algorithms, Jean Meeus, 1998, chapter 49.
+ */
+inline auto estimate(const int64_t lunation, const Phase phase) -> double {
+  const double k = static_cast<double>(lunation) + static_cast<double>(static_cast<uint8_t>(phase)) / PHASE_COUNT;
+  const double T = k / 1236.85;
+  const double T2 = T * T;
+  const double T3 = T2 * T;
+  const double T4 = T3 * T;
+
+  // The mean phase, (49.1).
+  const double mean = EPOCH + SYNODIC_MONTH * k + 0.00015437 * T2 - 0.000000150 * T3 + 0.00000000073 * T4;
+
+  // The arguments, in radians.
+  const auto rad = [](const double deg) { return deg / toolbox::DEG_PER_RAD; };
+  const double E  = 1.0 - 0.002516 * T - 0.0000074 * T2;
+  const double M  = rad(2.5534 + 29.10535670 * k - 0.0000014 * T2 - 0.00000011 * T3);
+  const double Mp = rad(201.5643 + 385.81693528 * k + 0.0107582 * T2 + 0.00001238 * T3 - 0.000000058 * T4);
+  const double F  = rad(160.7108 + 390.67050284 * k - 0.0016118 * T2 - 0.00000227 * T3 + 0.000000011 * T4);
+  const double Ω  = rad(124.7746 - 1.56375588 * k + 0.0020672 * T2 + 0.00000215 * T3);
+
+  const Corrections& corrections = (phase == Phase::NEW_MOON)  ? NEW_MOON_CORRECTIONS 
+                                 : (phase == Phase::FULL_MOON) ? FULL_MOON_CORRECTIONS 
+                                 : QUARTER_CORRECTIONS;
+
+  double correction = 0.0;
+  for (const auto& term : corrections) {
+    const double argument = term.M * M + term.Mp * Mp + term.F * F + term.Ω * Ω;
+    correction += term.amplitude * std::pow(E, term.E) * std::sin(argument);
+  }
+
+  // The quarters have an additional correction.
+  if (phase == Phase::FIRST_QUARTER or phase == Phase::LAST_QUARTER) {
+    const double W = 0.00306 - 0.00038 * E * std::cos(M) + 0.00026 * std::cos(Mp) 
+                   - 0.00002 * std::cos(Mp - M) + 0.00002 * std::cos(Mp + M) + 0.00002 * std::cos(2.0 * F);
+    correction += (phase == Phase::FIRST_QUARTER) ? W : -W;
+  }
+
+  for (const auto& term : PLANETARY_CORRECTIONS) {
+    correction += term.amplitude * std::sin(rad(term.A0 + term.A1 * k + term.A2 * T2));
+  }
+
+  return mean + correction;
+}
+
+
+/**
+ * @brief Get the lunation whose mean new moon is at or before the given moment.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The lunation number, see `estimate`.
+ */
+inline auto mean_lunation(const double jde) -> int64_t {
+  return static_cast<int64_t>(std::floor((jde - EPOCH) / SYNODIC_MONTH));
+}
+
+} // namespace meeus
+
+#pragma endregion
+
+
+#pragma region Phase Solver
+
+/**
+ * @brief Calculate how far the Moon is from the phase, and how fast it approaches it.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param phase The phase.
+ * @return The excess of the apparent longitude of the Moon over that of the Sun, minus the target elongation, 
+ *         in degrees in the range of [-180, 180]; and its rate, in degrees per day.
+ */
+inline auto elongation_offset(const double jde, const Phase phase) -> std::pair<double, double> {
+  // The Sun and the Moon share one pass of the nutation series.
+  const auto nutation = astro::earth::nutation::compute_with_rate(jde);
+  const auto sun = astro::sun::geocentric_coord::apparent_with_rate(jde, nutation);
+  const auto moon = astro::moon::geocentric_coord::apparent_with_rate(jde, nutation);
+
+  const double excess = moon.coord.λ.deg() - sun.coord.λ.deg();
+  return { std::remainder(excess - elongation(phase), 360.0), moon.rate.λ - sun.rate.λ };
+}
+
+
+/**
+ * @brief Solve the moment of a principal phase, with Newton's method starting from `meeus::estimate`.
+ * @param lunation The lunation number, see `meeus::estimate`.
+ * @param phase The phase.
+ * @param iterations The maximum number of iterations. Default is 10.
+ * @param tolerance The iteration stops after a step shorter than this, in seconds of time. Default is 0.1.
+ * @return The JDE of the phase.
+ * @throw std::runtime_error If the iteration does not converge.
+ * @details The estimate is within a few minutes, so it takes 1 or 2 steps. Newton's method converges quadratically, 
+ *          so the error left after a step shorter than `tolerance` is below the resolution of a JDE. See `astro::solve::newton`.
+ */
+inline auto solve(
+  const int64_t lunation, 
+  const Phase phase, 
+  const std::size_t iterations = 10, 
+  const double tolerance = 0.1
+) -> double {
+  const auto f = [phase](const double jde) -> astro::solve::Sample {
+    const auto [offset, rate] = elongation_offset(jde, phase);
+    return { .value = offset, .derivative = rate };
+  };
+
+  const auto result = astro::solve::newton(
+    f, meeus::estimate(lunation, phase), { .tolerance = tolerance, .max_iterations = iterations }
+  );
+
+  if (!result.converged) [[unlikely]] {
+    throw std::runtime_error {
+      std::format("The phase {} of the lunation {} does not converge.", static_cast<uint8_t>(phase), lunation)
+    };
+  }
+
+  return result.root;
+}
+
+
+/** @struct The moment of a principal phase. */
+struct PhaseMoment {
+  Phase phase;
+  int64_t lunation; // See `meeus::estimate`.
+  double jde;
+};
+
+
+/**
+ * @brief Generator of the principal phases at or after a moment, in time order.
+ *        Every phase is solved on demand, with no bracketing; see `solve`.
+ */
+// TODO: Use `std::generator` when supported.
+struct PhaseGenerator {
+private:
+  int64_t _quarter; // `4 * lunation + phase` of the next phase to yield.
+  int64_t _stride;  // 1 to yield every phase, or 4 to yield a single phase.
+  double  _jde;     // The JDE of `_quarter`, or NaN if not solved yet.
+
+  [[nodiscard]] auto lunation() const -> int64_t {
+    return (_quarter >= 0 ? _quarter : _quarter - (PHASE_COUNT - 1)) / PHASE_COUNT; // Rounded towards -∞.
+  }
+
+  [[nodiscard]] auto phase() const -> Phase {
+    return static_cast<Phase>(_quarter - lunation() * PHASE_COUNT);
+  }
+
+  PhaseGenerator(const double start_jde, const Phase first, const int64_t stride) 
+    : _quarter { (meeus::mean_lunation(start_jde) - 1) * PHASE_COUNT + static_cast<uint8_t>(first) }, 
+      _stride { stride },
+      _jde { NAN } {
+    // Skip the phases that are clearly before `start_jde`, with the cheap estimates.
+    while (meeus::estimate(lunation(), phase()) < start_jde - 0.5) {
+      _quarter += _stride;
+    }
+
+    _jde = solve(lunation(), phase());
+    while (_jde < start_jde) {
+      _quarter += _stride;
+      _jde = solve(lunation(), phase());
+    }
+  }
+
+public:
+  /** @brief Generate every principal phase at or after `start_jde`. */
+  explicit PhaseGenerator(const double start_jde) 
+    : PhaseGenerator(start_jde, Phase::NEW_MOON, 1) {}
+
+  /** @brief Generate the given phase only, at or after `start_jde`. */
+  PhaseGenerator(const double start_jde, const Phase phase) 
+    : PhaseGenerator(start_jde, phase, PHASE_COUNT) {}
+
+  auto next() -> PhaseMoment {
+    if (std::isnan(_jde)) {
+      _jde = solve(lunation(), phase());
+    }
+
+    const PhaseMoment moment { phase(), lunation(), _jde };
+    _quarter += _stride;
+    _jde = NAN;
+    return moment;
+  }
+};
+
+
+/**
+ * @brief Get the range of a Gregorian year in JDE.
+ * @param year The Gregorian year.
+ * @return The first moment of the year, inclusive, and the first moment of the next year, exclusive.
+ */
+inline auto year_range(const int32_t year) -> std::pair<double, double> {
+  const calendar::Datetime start_moment { util::to_ymd(year, 1, 1), 0.0 };
+  const calendar::Datetime end_moment { util::to_ymd(year + 1, 1, 1), 0.0 };
+
+  // TODO: Use `utc_to_jde` when supported.
+  return { astro::julian_day::ut1_to_jde(start_moment), astro::julian_day::ut1_to_jde(end_moment) };
+}
+
+
+/**
+ * @brief Calculate the moments of all principal phases of the Moon in a given Gregorian year.
+          计算某一个公历年中的朔、上弦、望、下弦时刻。
+ * @param year The Gregorian year.
+ * @return The phases in time order, with the moments in JDE (Julian Ephemeris Day).
+ */
+inline auto phases(const int32_t year) -> std::vector<PhaseMoment> {
+  const auto [start_jde, end_jde] = year_range(year);
+
+  PhaseGenerator gen(start_jde);
+  std::vector<PhaseMoment> phases;
+
+  while (true) {
+    const auto moment = gen.next();
+    if (moment.jde >= end_jde) {
+      break;
+    }
+
+    phases.push_back(moment);
+  }
+
+  return phases;
+}
+
+#pragma endregion
+
+} // namespace astro::moon_phase
 
 
 namespace astro::moon_phase::new_moon {
@@ -48,8 +443,10 @@ namespace astro::moon_phase::new_moon {
  * @see VSOP87D, ELP2000-82B, and Astronomical Algorithms, Jean Meeus, 1998.
  */
 inline auto longitude_diff(const double jde) -> double {
-  const auto sun_apparent_lon = astro::sun::geocentric_coord::apparent(jde).λ;
-  const auto moon_apparent_lon = astro::moon::geocentric_coord::apparent(jde).λ;
+  // The Sun and the Moon share the context, so the nutation series is evaluated once.
+  const auto ctx = astro::epoch::make_context(jde);
+  const auto sun_apparent_lon = astro::sun::geocentric_coord::apparent(ctx).λ;
+  const auto moon_apparent_lon = astro::moon::geocentric_coord::apparent(ctx).λ;
   const auto diff = moon_apparent_lon - sun_apparent_lon;
   return diff.normalize().deg();
 }
@@ -58,64 +455,57 @@ inline auto longitude_diff(const double jde) -> double {
 /**
  * @brief Apply Newton's method to find the jde, when the Sun and Moon are at the same apparent longitude.
  * @param left_jde The left bound of the search, inclusive.
- * @param right_jde The right bound of the search, exclusive.
- * @param iterations The maximum number of iterations. Default is 20.
- * @param epsilon The tolerance. Default is 1e-8.
+ * @param right_jde The right bound of the search, inclusive.
+ * @param iterations The maximum number of iterations. Default is 30.
+ * @param tolerance The iteration stops after a step shorter than this, in seconds of time. Default is 0.1.
  * @return The jde of the conjunction.
- * @note It is the caller's responsibility to ensure the root exists in the range of [left_jde, right_jde).
- * @throw std::invalid_argument If no root exists in the range of [left_jde, right_jde).
+ * @note It is the caller's responsibility to ensure the root exists in the range of [left_jde, right_jde].
+ * @throw std::invalid_argument If the Moon does not pass the Sun in the range of [left_jde, right_jde], 
+ *                              i.e. unless `f(left_jde) <= 0 <= f(right_jde)`.
+ * @throw std::runtime_error If the iteration does not converge.
+ * @details The derivative is the difference of the closed-form longitude rates of the Moon and the Sun, 
+ *          see `apparent_with_rate`, so every iteration evaluates the Sun, the Moon and the nutation once.
+ *          The steps are kept in the range, see `astro::solve::bracketed_newton`. A range where `f` falls instead 
+ *          spans the fold at 345°, where the solver would settle on the jump, so it is rejected.
  */
 inline auto newton_method(
   const double left_jde, 
   const double right_jde,            // NOLINT(bugprone-easily-swappable-parameters)
   const std::size_t iterations = 30,
-  const double epsilon = 1e-15
+  const double tolerance = 0.1
 ) -> double {
+  // Define the function `f` which is continuous around the conjunction, together with its derivative.
+  // The difference is mapped to (-15, 345], so `f` changes its sign only at the conjunction, in a range shorter than a month.
+  // We are going to find the root where `f` evaluates to 0.
+  const auto f = [](const double jde) -> astro::solve::Sample {
+    const auto nutation = astro::earth::nutation::compute_with_rate(jde);
+    const auto sun = astro::sun::geocentric_coord::apparent_with_rate(jde, nutation);
+    const auto moon = astro::moon::geocentric_coord::apparent_with_rate(jde, nutation);
 
-  // Make sure the root exists in the range of [left_jde, right_jde).
-  const double left_diff = longitude_diff(left_jde);
-  const double right_diff = longitude_diff(right_jde);
+    const double diff = (moon.coord.λ - sun.coord.λ).normalize().deg();
+    return { .value = diff > 345.0 ? diff - 360.0 : diff, .derivative = moon.rate.λ - sun.rate.λ };
+  };
 
-  if (left_diff <= 345.0 or right_diff >= 15.0) [[unlikely]] {
+  // The bounds are checked before solving, and their values are passed on, so they are evaluated once.
+  const double left_value = f(left_jde).value;
+  const double right_value = f(right_jde).value;
+  if (left_value > 0.0 or right_value < 0.0) [[unlikely]] {
     throw std::invalid_argument {
-      std::format("No root between {} and {}.", left_jde, right_jde)
+      std::format("The Moon does not pass the Sun between {} and {}.", left_jde, right_jde)
     };
   }
 
-  // Define the function `f` which is differentiable.
-  // We are going to find the root where `f` evaluates to 0.
-  const auto f = [&](const double jde) -> double {
-    const double diff = longitude_diff(jde);
-    if (diff > 345.0) {
-      return diff - 360.0;
-    }
-    return diff;
-  };
-
-  // Start approximating the root.
-  double h = 5e-4;
-  double guess = (left_jde + right_jde) / 2.0;
-  
-  for (std::size_t i = 0; i < iterations; ++i) {
-    const double f_prime = (f(guess + h) - f(guess - h)) / (2.0 * h);
-    double next_guess = guess - f(guess) / f_prime;
-
-    // Ensure next guess is within the range of [left_jde, right_jde).
-    if (next_guess < left_jde) {
-      next_guess = left_jde;
-    } else if (next_guess >= right_jde) {
-      next_guess = right_jde - 1e-20;
-    }
-
-    if (std::fabs(next_guess - guess) < epsilon) {
-      return next_guess;
-    }
+  const auto result = astro::solve::bracketed_newton(
+    f, left_jde, right_jde, left_value, right_value, { .tolerance = tolerance, .max_iterations = iterations }
+  );
 
-    guess = next_guess;
-    h = (h > 1e-10) ? h / std::numbers::phi : h; // Make the step size adaptive, for faster convergence.
+  if (!result.converged) [[unlikely]] {
+    throw std::runtime_error {
+      std::format("The conjunction between {} and {} does not converge.", left_jde, right_jde)
+    };
   }
 
-  return guess;
+  return result.root;
 }
 
 
@@ -169,24 +559,137 @@ inline auto next_root(const double jde) -> double {
   return newton_method(left, right);
 };
 
+#pragma region New Moon Table
+
+// The new moons can also be looked up in a precomputed table (see `astro::new_moon_table`), instead of being solved. 
+// Once a table is in use, `RootGenerator` (and so `moments`) looks up the lunations it holds, and solves the others.
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+inline std::mutex TABLE_MUTEX;
+inline std::shared_ptr<const astro::new_moon_table::Table> ACTIVE_TABLE;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+
+/**
+ * @brief Solve the new moons and write the table file.
+ * @param path The path of the file to write.
+ * @param start_jde The start of the coverage.
+ * @param end_jde The end of the coverage. The table holds every new moon between, and one more on each side.
+ * @throw std::invalid_argument If the range is invalid.
+ * @throw std::runtime_error If the file cannot be written.
+ */
+inline void generate_table(const std::string& path, const double start_jde, const double end_jde) {
+  if (!(start_jde < end_jde)) {
+    throw std::invalid_argument { "Invalid range." };
+  }
+
+  // The new moons are within 1 day or so of the mean new moons.
+  const int64_t first_lunation = meeus::mean_lunation(start_jde) - 1;
+  const int64_t last_lunation = meeus::mean_lunation(end_jde) + 1;
+  astro::new_moon_table::generate(
+    path, 
+    first_lunation, 
+    last_lunation, 
+    [](const int64_t lunation) { return solve(lunation, Phase::NEW_MOON); }, 
+    { .epoch = meeus::EPOCH, .synodic_month = meeus::SYNODIC_MONTH }
+  );
+}
+
+/**
+ * @brief Load the table file, and use it in `RootGenerator` from now on.
+ * @param path The path of the file, written by `generate_table`.
+ * @throw std::runtime_error If the file is invalid. The table in use (if any) is kept in this case.
+ */
+inline void use_table(const std::string& path) {
+  auto table = std::make_shared<const astro::new_moon_table::Table>(path);
+  const std::lock_guard lock { TABLE_MUTEX };
+  ACTIVE_TABLE = std::move(table);
+}
+
+/** @brief Stop using the table, i.e. the new moons are solved again. */
+inline void clear_table() {
+  const std::lock_guard lock { TABLE_MUTEX };
+  ACTIVE_TABLE.reset();
+}
+
+/** @brief Return the table in use, or `nullptr` if there is none. */
+inline auto active_table() -> std::shared_ptr<const astro::new_moon_table::Table> {
+  const std::lock_guard lock { TABLE_MUTEX };
+  return ACTIVE_TABLE;
+}
+
+
+/** @struct The result of `verify_table`. */
+struct Verification {
+  std::size_t count = 0; // The number of lunations solved.
+  double max_diff = 0.0; // The largest difference between the table and the solved new moons, in days.
+};
+
+/**
+ * @brief Solve a sample of the lunations in the table again, to detect a drift of the table from the ephemeris.
+ * @param table The table.
+ * @param stride Every `stride`-th lunation is solved, from the first one. The last one is always solved. Default is 97.
+ * @return The number of lunations solved, and the largest difference.
+ * @note A table solved with the same ephemeris is within half of `new_moon_table::UNIT` (about 40 microseconds).
+ * @throw std::invalid_argument If `stride` is not positive.
+ */
+inline auto verify_table(const astro::new_moon_table::Table& table, const int64_t stride = 97) -> Verification {
+  if (stride <= 0) {
+    throw std::invalid_argument { "The stride must be positive." };
+  }
+
+  Verification result;
+  const auto verify = [&](const int64_t lunation) {
+    const double diff = std::fabs(table.lookup(lunation) - solve(lunation, Phase::NEW_MOON));
+    result.max_diff = std::max(result.max_diff, diff);
+    ++result.count;
+  };
+
+  for (int64_t lunation = table.first_lunation(); lunation < table.last_lunation(); lunation += stride) {
+    verify(lunation);
+  }
+  verify(table.last_lunation());
+  return result;
+}
+
+#pragma endregion
+
+
 /**
  * @brief Generator for finding the roots (i.e. conjunction moments of the Sun and Moon).
+ * @details The roots are looked up in the table in use at construction (see `use_table`) if it holds them.
+ *          Otherwise, they are solved from the estimates of the new moons, with no bracketing; see `solve`.
  */
-// TODO: Use `std::generator` when supported.
 struct RootGenerator {
 private:
-  double _root;
+  std::shared_ptr<const astro::new_moon_table::Table> _table; // The table in use at construction, if any.
+  int64_t _lunation; // The lunation of the next root.
+  double  _root;     // The next root, or NaN if not looked up or solved yet.
 
 public:
-  explicit RootGenerator(const double start_jde) {
-    const auto [left, right] = first_root_range_after(start_jde);
-    const double first_root = newton_method(left, right);
-    _root = first_root;
+  explicit RootGenerator(const double start_jde) 
+    : _table { active_table() }, 
+      _lunation { 0 },
+      _root { NAN } {
+    if (_table != nullptr and _table->covers(start_jde)) {
+      _lunation = _table->first_at_or_after(start_jde);
+      return;
+    }
+
+    const auto first = PhaseGenerator { start_jde, Phase::NEW_MOON }.next();
+    _lunation = first.lunation;
+    _root = first.jde;
   }
 
   auto next() -> double {
+    if (std::isnan(_root)) {
+      const bool in_table = _table != nullptr and _table->contains(_lunation);
+      _root = in_table ? _table->lookup(_lunation) : solve(_lunation, Phase::NEW_MOON);
+    }
+
     const double root = _root;
-    _root = next_root(_root);
+    ++_lunation;
+    _root = NAN;
     return root;
   }
 };
@@ -202,22 +705,7 @@ public:
  * @see VSOP87D, ELP2000-82B, and Astronomical Algorithms, Jean Meeus, 1998.
  */
 inline auto moments(const int32_t year) -> std::vector<double> {
-  // The first moment of the year, inclusive.
-  const calendar::Datetime start_moment {
-    util::to_ymd(year, 1, 1),
-    0.0,
-  };
-
-  // The last moment of the year, exclusive.
-  const calendar::Datetime end_moment {
-    util::to_ymd(year + 1, 1, 1),
-    0.0,
-  };
-
-  // Convert to JDEs.
-  // TODO: Use `utc_to_jde` when supported.
-  const auto start_jde = astro::julian_day::ut1_to_jde(start_moment);
-  const auto end_jde = astro::julian_day::ut1_to_jde(end_moment);
+  const auto [start_jde, end_jde] = year_range(year);
 
   RootGenerator gen(start_jde);
   std::vector<double> roots;
@@ -0,0 +1,308 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "ephemeris.hpp"
+
+namespace astro::new_moon_table {
+
+// A precomputed table of the new moons (i.e. the conjunctions of the Sun and the Moon), indexed by lunation number.
+// The new moon of the lunation `k` is stored as its residual from the mean new moon, `epoch + synodic_month * k`, 
+// which is within a day or so. The residual is a fixed-point number of `UNIT`, so every new moon takes 4 bytes.
+
+using astro::ephemeris::fnv1a;
+using astro::ephemeris::to_little_endian;
+using astro::ephemeris::MappedFile;
+
+#pragma region File Format
+
+// The file is little-endian, and consists of a 64-byte `Header` followed by the payload.
+// The payload holds `count` residuals as int32, of the lunations `first_lunation` to `first_lunation + count - 1`.
+
+/** @brief The magic bytes at the start of a new moon table file. */
+constexpr std::array<char, 8> MAGIC { 'C', 'C', 'N', 'M', 'O', 'O', 'N', '\0' };
+
+/** @brief The version of the file format. Files of other versions are rejected. */
+constexpr uint32_t VERSION = 1;
+
+/** @brief The fixed-point unit of the residuals, in days. It's 2^-30 days, i.e. about 80 microseconds. */
+constexpr double UNIT = 0x1p-30;
+
+/** @struct The header of a new moon table file. */
+struct Header {
+  std::array<char, 8> magic;          // `MAGIC`
+  uint32_t            version;        // `VERSION`
+  uint32_t            reserved;       // Always 0.
+  double              epoch;          // The JDE of the mean new moon of the lunation 0.
+  double              synodic_month;  // The mean length of the synodic month, in days.
+  double              unit;           // The fixed-point unit of the residuals, in days.
+  int64_t             first_lunation; // The lunation of the first residual.
+  uint64_t            count;          // The number of residuals.
+  uint64_t            checksum;       // The FNV-1a hash of the payload.
+};
+
+static_assert(sizeof(Header) == 64);
+static_assert(std::is_trivially_copyable_v<Header>);
+
+
+/** @brief Convert all the fields of the header between the native byte order and little-endian. */
+inline auto to_little_endian(Header header) -> Header {
+  header.version        = to_little_endian(header.version);
+  header.reserved       = to_little_endian(header.reserved);
+  header.epoch          = to_little_endian(header.epoch);
+  header.synodic_month  = to_little_endian(header.synodic_month);
+  header.unit           = to_little_endian(header.unit);
+  header.first_lunation = to_little_endian(header.first_lunation);
+  header.count          = to_little_endian(header.count);
+  header.checksum       = to_little_endian(header.checksum);
+  return header;
+}
+
+#pragma endregion
+
+
+#pragma region Generation
+
+/** @brief A function that solves the new moon of a lunation, in JDE. */
+using Solver = std::function<double(int64_t)>;
+
+/** @struct The mean lunation that the residuals are relative to. */
+struct MeanLunation {
+  double epoch;         // The JDE of the mean new moon of the lunation 0.
+  double synodic_month; // The mean length of the synodic month, in days.
+};
+
+
+/**
+ * @brief Solve the new moons and write the table file.
+ * @param path The path of the file to write.
+ * @param first_lunation The first lunation of the table.
+ * @param last_lunation The last lunation of the table, inclusive.
+ * @param solver The function that solves the new moon of a lunation.
+ * @param mean The mean lunation.
+ * @throw std::invalid_argument If the range is empty.
+ * @throw std::runtime_error If a residual does not fit in the fixed-point format, or the file cannot be written.
+ */
+inline void generate(
+  const std::string& path, 
+  const int64_t first_lunation, 
+  const int64_t last_lunation,  // NOLINT(bugprone-easily-swappable-parameters)
+  const Solver& solver, 
+  const MeanLunation& mean
+) {
+  if (first_lunation > last_lunation) {
+    throw std::invalid_argument { "Invalid range of lunations." };
+  }
+
+  const auto count = static_cast<uint64_t>(last_lunation - first_lunation) + 1;
+  std::vector<int32_t> payload;
+  payload.reserve(count);
+
+  for (int64_t k = first_lunation; k <= last_lunation; ++k) {
+    const double residual = std::round((solver(k) - (mean.epoch + mean.synodic_month * static_cast<double>(k))) / UNIT);
+    if (!(std::abs(residual) <= std::numeric_limits<int32_t>::max())) {
+      throw std::runtime_error { "The new moon of the lunation " + std::to_string(k) + " is too far from the mean." };
+    }
+    payload.push_back(to_little_endian(static_cast<int32_t>(residual)));
+  }
+  const auto bytes = std::as_bytes(std::span { payload });
+
+  const Header header {
+    .magic = MAGIC,
+    .version = VERSION,
+    .reserved = 0,
+    .epoch = mean.epoch,
+    .synodic_month = mean.synodic_month,
+    .unit = UNIT,
+    .first_lunation = first_lunation,
+    .count = count,
+    .checksum = fnv1a(bytes),
+  };
+  const Header le_header = to_little_endian(header);
+
+  std::ofstream file { path, std::ios::binary | std::ios::trunc };
+  file.write(reinterpret_cast<const char*>(&le_header), sizeof(Header)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!file) {
+    throw std::runtime_error { "Failed to write the new moon table file: " + path };
+  }
+}
+
+#pragma endregion
+
+
+#pragma region Lookup
+
+/**
+ * @class A read-only new moon table file.
+ * @details On POSIX systems with little-endian CPUs, the file is memory-mapped, and the residuals are used in place.
+ *          Otherwise, the file is read (and byte-swapped if necessary) into memory.
+ */
+class Table {
+public:
+  /**
+   * @brief Open and validate a new moon table file.
+   * @param path The path of the file.
+   * @throw std::runtime_error If the file cannot be read, or is not a valid new moon table file of `VERSION`, 
+   *                           or its size or checksum does not match its header.
+   */
+  explicit Table(const std::string& path) : _file { path } {
+    const auto bytes = _file.bytes();
+    if (bytes.size() < sizeof(Header)) {
+      throw std::runtime_error { "The new moon table file is truncated: " + path };
+    }
+
+    std::memcpy(&_header, bytes.data(), sizeof(Header));
+    _header = to_little_endian(_header);
+    if (_header.magic != MAGIC) {
+      throw std::runtime_error { "Not a new moon table file: " + path };
+    }
+    if (_header.version != VERSION) {
+      throw std::runtime_error { "Unsupported new moon table file version " + std::to_string(_header.version) + ": " + path };
+    }
+    if (_header.count == 0 or !(_header.unit > 0.0) or !(_header.synodic_month > 0.0)) {
+      throw std::runtime_error { "Invalid new moon table file header: " + path };
+    }
+
+    // Divided rather than multiplied, since a crafted count can wrap `count * sizeof(int32_t)` around.
+    const auto payload = bytes.subspan(sizeof(Header));
+    if (payload.size() % sizeof(int32_t) != 0 or _header.count != payload.size() / sizeof(int32_t)) {
+      throw std::runtime_error { "The size of the new moon table file does not match its header: " + path };
+    }
+    if (fnv1a(payload) != _header.checksum) {
+      throw std::runtime_error { "The checksum of the new moon table file does not match: " + path };
+    }
+
+    if constexpr (std::endian::native == std::endian::little) {
+      if (_file.is_mapped()) {
+        // Zero-copy: the payload starts at offset 64 of a page-aligned mapping, so it's aligned for int32.
+        _residuals = { reinterpret_cast<const int32_t*>(payload.data()), _header.count }; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return;
+      }
+    }
+
+    _owned.resize(_header.count);
+    std::memcpy(_owned.data(), payload.data(), payload.size());
+    for (int32_t& residual : _owned) {
+      residual = to_little_endian(residual);
+    }
+    _residuals = _owned;
+
+    // The raw bytes are no longer needed.
+    _file.close();
+  }
+
+  /** @brief Return the header of the file. */
+  [[nodiscard]] auto header() const -> const Header& {
+    return _header;
+  }
+
+  /** @brief Return the first lunation of the table. */
+  [[nodiscard]] auto first_lunation() const -> int64_t {
+    return _header.first_lunation;
+  }
+
+  /** @brief Return the last lunation of the table, inclusive. */
+  [[nodiscard]] auto last_lunation() const -> int64_t {
+    return _header.first_lunation + static_cast<int64_t>(_header.count) - 1;
+  }
+
+  /** @brief Return true if the new moon of the lunation is in the table. */
+  [[nodiscard]] auto contains(const int64_t lunation) const -> bool {
+    return first_lunation() <= lunation and lunation <= last_lunation();
+  }
+
+  /**
+   * @brief Look up the new moon of a lunation.
+   * @param lunation The lunation number.
+   * @return The JDE of the new moon, to within half of `UNIT` of the solved one.
+   * @throw std::out_of_range If the lunation is not in the table.
+   */
+  [[nodiscard]] auto lookup(const int64_t lunation) const -> double {
+    if (!contains(lunation)) {
+      throw std::out_of_range { "The lunation " + std::to_string(lunation) + " is not in the new moon table." };
+    }
+    return decode(lunation);
+  }
+
+  /** @brief Return true if the first new moon at or after the given JDE is in the table. */
+  [[nodiscard]] auto covers(const double jde) const -> bool {
+    return decode(first_lunation()) <= jde and jde <= decode(last_lunation());
+  }
+
+  /**
+   * @brief Find the lunation of the first new moon at or after the given JDE, by binary search over the lunations.
+   * @param jde The julian ephemeris day number.
+   * @return The lunation number.
+   * @throw std::out_of_range If the JDE is not covered by the table.
+   */
+  [[nodiscard]] auto first_at_or_after(const double jde) const -> int64_t {
+    if (!covers(jde)) {
+      throw std::out_of_range { "The JDE is not covered by the new moon table." };
+    }
+
+    int64_t low = first_lunation();
+    int64_t high = last_lunation();
+    while (low < high) {
+      const int64_t mid = low + (high - low) / 2;
+      if (decode(mid) < jde) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+private:
+  /** @brief Decode the new moon of a lunation in the table. */
+  [[nodiscard]] auto decode(const int64_t lunation) const -> double {
+    const auto index = static_cast<std::size_t>(lunation - _header.first_lunation);
+    const double mean = _header.epoch + _header.synodic_month * static_cast<double>(lunation);
+    return mean + static_cast<double>(_residuals[index]) * _header.unit;
+  }
+
+  Header _header {};
+  std::span<const int32_t> _residuals;
+
+  MappedFile _file;
+  std::vector<int32_t> _owned; // The residuals, when they cannot be used in place.
+};
+
+#pragma endregion
+
+} // namespace astro::new_moon_table
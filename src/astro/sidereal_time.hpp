@@ -28,6 +28,7 @@
 #include "toolbox.hpp"
 #include "julian_day.hpp"
 #include "earth.hpp"
+#include "epoch.hpp"
 
 
 namespace astro::sidereal {
@@ -64,6 +65,25 @@ inline auto greenwich_mean(const double jd_ut1) -> astro::toolbox::Angle<astro::
   return Angle<DEG> { θ0 }.normalize();
 }
 
+/**
+ * @brief Compute the Greenwich Apparent Sidereal Time (GAST) for a UT1 instant, with a shared epoch context.
+ * @param jd_ut1 The julian day number, on the **UT1** scale (see `greenwich_mean`'s warning).
+ * @param ctx The context of the same instant, on the **TT** scale; see `astro::epoch::make_context`.
+ * @return The GAST, normalized to [0°, 360°); see the overload taking `jde_tt` for the details.
+ */
+inline auto greenwich_apparent(
+  const double jd_ut1,
+  const astro::epoch::EpochContext& ctx
+) -> astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG> {
+  using astro::toolbox::Angle;
+  using astro::toolbox::AngleUnit::DEG;
+
+  // The nutation correction in right ascension: Δψ·cos ε.
+  const Angle<DEG> correction = ctx.nutation.Δψ * std::cos(ctx.ε.rad());
+
+  return (greenwich_mean(jd_ut1) + correction).normalize();
+}
+
 /**
  * @brief Compute the Greenwich Apparent Sidereal Time (GAST) for a UT1 instant.
  * @param jd_ut1 The julian day number, on the **UT1** scale (see `greenwich_mean`'s warning).
@@ -83,15 +103,8 @@ inline auto greenwich_apparent(
   const double jde_tt,
   const astro::earth::nutation::Model model = astro::earth::nutation::Model::IAU_1980
 ) -> astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG> {
-  using astro::toolbox::Angle;
-  using astro::toolbox::AngleUnit::DEG;
-
-  // The nutation correction in right ascension: Δψ·cos ε. Nutation is computed on the TT scale.
-  const auto Δψ = astro::earth::nutation::longitude(jde_tt, model);
-  const auto ε  = astro::earth::obliquity::true_obliquity(jde_tt, model);
-  const Angle<DEG> correction = Δψ * std::cos(ε.rad());
-
-  return (greenwich_mean(jd_ut1) + correction).normalize();
+  // Nutation is computed on the TT scale. Δψ and Δε come from the same pass over the nutation terms.
+  return greenwich_apparent(jd_ut1, astro::epoch::make_context(jde_tt, model));
 }
 
 /**
@@ -116,4 +129,19 @@ inline auto local_apparent(
   return (greenwich_apparent(jd_ut1, jde_tt, model) - longitude).normalize();
 }
 
+/**
+ * @brief Compute the Local Apparent Sidereal Time (LAST) for an observer, with a shared epoch context.
+ * @param jd_ut1 The julian day number, on the **UT1** scale (see `greenwich_mean`'s warning).
+ * @param ctx The context of the same instant, on the **TT** scale; see `astro::epoch::make_context`.
+ * @param longitude The observer's geographic longitude, measured **positive west** from Greenwich.
+ * @return The same LAST as `local_apparent(jd_ut1, ctx.jde, longitude, ctx.model)`.
+ */
+inline auto local_apparent(
+  const double jd_ut1,
+  const astro::epoch::EpochContext& ctx,
+  const astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG>& longitude
+) -> astro::toolbox::Angle<astro::toolbox::AngleUnit::DEG> {
+  return (greenwich_apparent(jd_ut1, ctx) - longitude).normalize();
+}
+
 } // namespace astro::sidereal
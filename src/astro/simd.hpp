@@ -0,0 +1,391 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <new>
+#include <span>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace astro::simd {
+
+// This namespace holds a small, portable vector math kernel used by the series evaluators (VSOP87D, ...).
+//
+// Vectors are expressed with the GCC/Clang `vector_size` extension, so the same source lowers to
+// AVX-512, AVX2/AVX, SSE2 or NEON instructions, depending on the target the translation unit is built for.
+// The lane count is picked at compile time from the target macros; no runtime CPU-feature dispatch is done,
+// since this library is header-only and every consumer decides its own `-march`.
+//
+// All kernels are written with plain arithmetic only (no branches, no lane selects), so they are also valid
+// when instantiated on plain `double`/`float`, which is how the scalar tails and the unit tests use them.
+
+#pragma region Vector Types
+
+/** @brief The number of `double` lanes in a vector, i.e. the widest vector register of the target. */
+#if defined(__AVX512F__)
+constexpr std::size_t LANES = 8;
+#elif defined(__AVX__)
+constexpr std::size_t LANES = 4;
+#elif defined(__SSE2__) || defined(__ARM_NEON) || defined(__aarch64__)
+constexpr std::size_t LANES = 2;
+#else
+constexpr std::size_t LANES = 1; // No vector unit; the kernels below degrade to scalar code.
+#endif
+
+/** @brief The alignment (in bytes) used for SoA storage, enough for any vector width above. */
+constexpr std::size_t ALIGNMENT = 64;
+
+/** @brief A vector of `LANES` doubles. */
+using VecD = double __attribute__((vector_size(LANES * sizeof(double))));
+
+/** @brief Round `n` up to the next multiple of `LANES`. */
+constexpr auto padded(const std::size_t n) -> std::size_t {
+  return (n + LANES - 1) / LANES * LANES;
+}
+
+/** @struct The allocator of `simd::ALIGNMENT`-aligned storage. */
+template <typename T>
+struct AlignedAllocator {
+  using value_type = T;
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U>& /*unused*/) noexcept {} // NOLINT(google-explicit-constructor)
+
+  [[nodiscard]] auto allocate(const std::size_t n) -> T* {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t { ALIGNMENT }));
+  }
+
+  void deallocate(T* const p, const std::size_t /*unused*/) noexcept {
+    ::operator delete(p, std::align_val_t { ALIGNMENT });
+  }
+
+  friend auto operator==(const AlignedAllocator& /*unused*/, const AlignedAllocator& /*unused*/) -> bool { return true; }
+};
+
+/** @brief A vector of doubles, aligned for the SIMD kernels. */
+using AlignedVector = std::vector<double, AlignedAllocator<double>>;
+
+/** @brief Broadcast a scalar to all lanes. */
+inline auto splat(const double x) -> VecD {
+  return VecD {} + x;
+}
+
+/** 
+ * @brief Load `LANES` doubles starting at `data[index]`. 
+ * @note The caller guarantees that `index + LANES <= data.size()`, which SoA storage does by padding.
+ */
+inline auto load(const std::span<const double> data, const std::size_t index) -> VecD {
+  VecD v;
+  std::memcpy(&v, data.data() + index, sizeof(VecD));
+  return v;
+}
+
+/** @brief Store `LANES` doubles starting at `data[index]`. */
+inline void store(const std::span<double> data, const std::size_t index, const VecD& v) {
+  std::memcpy(data.data() + index, &v, sizeof(VecD));
+}
+
+/** @brief Add all lanes to `init`, one by one in lane order, i.e. the same rounding as a sequential loop. */
+inline auto accumulate(const VecD& v, double init) -> double {
+  for (std::size_t i = 0; i < LANES; ++i) {
+    init += v[i];
+  }
+  return init;
+}
+
+
+/** @brief The number of `float` lanes in a vector, i.e. twice `LANES` in the same register width. */
+constexpr std::size_t FLOAT_LANES = 2 * LANES;
+
+/** @brief A vector of `FLOAT_LANES` floats. */
+using VecF = float __attribute__((vector_size(FLOAT_LANES * sizeof(float))));
+
+/** @brief Round `n` up to the next multiple of `FLOAT_LANES`. */
+constexpr auto padded_float(const std::size_t n) -> std::size_t {
+  return (n + FLOAT_LANES - 1) / FLOAT_LANES * FLOAT_LANES;
+}
+
+/** @brief Broadcast a scalar to all float lanes. */
+inline auto splat_float(const float x) -> VecF {
+  return VecF {} + x;
+}
+
+/** 
+ * @brief Load `FLOAT_LANES` floats starting at `data[index]`. 
+ * @note The caller guarantees that `index + FLOAT_LANES <= data.size()`.
+ */
+inline auto load(const std::span<const float> data, const std::size_t index) -> VecF {
+  VecF v;
+  std::memcpy(&v, data.data() + index, sizeof(VecF));
+  return v;
+}
+
+/** @brief Convert two vectors of doubles to one vector of floats: `lo` fills the lower half of the lanes, and `hi` the upper half. */
+inline auto narrow(const VecD& lo, const VecD& hi) -> VecF {
+  // Concatenate in registers, then convert once; going through memory stalls on store forwarding.
+  return [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+    return __builtin_convertvector(__builtin_shufflevector(lo, hi, I...), VecF);
+  }(std::make_index_sequence<FLOAT_LANES> {});
+}
+
+/** @brief Add all float lanes to `init` in double precision, one by one in lane order. */
+inline auto accumulate(const VecF& v, double init) -> double {
+  for (std::size_t i = 0; i < FLOAT_LANES; ++i) {
+    init += static_cast<double>(v[i]);
+  }
+  return init;
+}
+
+#pragma endregion
+
+
+#pragma region Trigonometry
+
+/** @brief The largest |x| for which the range reduction below is exact (k·π is split into 30-bit parts). */
+constexpr double MAX_TRIG_ARGUMENT = 8388608.0 * 3.141592653589793; // 2^23·π
+
+/** @brief The documented bound of |simd::cos(x) - std::cos(x)| and |simd::sin(x) - std::sin(x)|, in ULPs of 1.0. */
+constexpr double TRIG_ULP_BOUND = 4.0;
+
+/**
+ * @brief Round to the nearest integer, ties to even, without leaving the vector unit.
+ * @note Adding and subtracting 1.5·2^52 forces the FPU to round at the units place.
+ *       Valid for |x| < 2^51, and relies on the build not enabling `-ffast-math` (which the project never does).
+ */
+template <typename T>
+inline auto round_nearest(const T x) -> T {
+  constexpr double MAGIC = 6755399441055744.0; // 1.5 · 2^52
+  return (x + MAGIC) - MAGIC;
+}
+
+/**
+ * @brief x - n·period, where n is the integer nearest to x / period, i.e. `std::remainder(x, period)`.
+ * @note The result is exact, as long as n·period is (e.g. a period of 360 and |x| < 2^50).
+ */
+template <typename T>
+inline auto remainder(const T x, const double period) -> T {
+  return x - round_nearest(x / period) * period;
+}
+
+/**
+ * @struct The result of the range reduction x = k·π + r.
+ * @note `sign` is (-1)^k, so that cos(x) = sign·cos(r) and sin(x) = sign·sin(r).
+ */
+template <typename T>
+struct Reduced {
+  T r;    // In [-π/2, π/2].
+  T sign; // Either 1.0 or -1.0.
+};
+
+/**
+ * @brief Reduce `x` (in radians) to [-π/2, π/2] with Cody-Waite's 3-part π.
+ * @param x The angle in radians, |x| < `MAX_TRIG_ARGUMENT`.
+ */
+template <typename T>
+inline auto reduce_pi(const T x) -> Reduced<T> {
+  // π = PI_A + PI_B + PI_C, where PI_A and PI_B carry 30 significant bits each, so k·PI_A and k·PI_B are exact.
+  constexpr double PI_A    = 0x1.921fb54000000p+1;
+  constexpr double PI_B    = 0x1.10b4611800000p-29;
+  constexpr double PI_C    = 0x1.313198a2e0370p-60;
+  constexpr double INV_PI  = 0.318309886183790671537767526745; // 1/π
+
+  const T k = round_nearest(x * INV_PI);
+  const T r = ((x - k * PI_A) - k * PI_B) - k * PI_C;
+
+  // (-1)^k without branches: `parity` is 0 for even k, and ±1 for odd k.
+  const T parity = k - 2.0 * round_nearest(k * 0.5);
+  const T sign = 1.0 - 2.0 * parity * parity;
+
+  return { .r = r, .sign = sign };
+}
+
+/** @brief cos(r) for r in [-π/2, π/2]; Taylor series to r^22, truncation error < 1e-19. */
+template <typename T>
+inline auto cos_kernel(const T r) -> T {
+  const T r2 = r * r;
+  T p = T {} + 1.0 / 1124000727777607680000.0; // 1/22!
+  p = p * r2 - 1.0 / 2432902008176640000.0; // 1/20!
+  p = p * r2 + 1.0 / 6402373705728000.0;    // 1/18!
+  p = p * r2 - 1.0 / 20922789888000.0;      // 1/16!
+  p = p * r2 + 1.0 / 87178291200.0;         // 1/14!
+  p = p * r2 - 1.0 / 479001600.0;           // 1/12!
+  p = p * r2 + 1.0 / 3628800.0;             // 1/10!
+  p = p * r2 - 1.0 / 40320.0;               // 1/8!
+  p = p * r2 + 1.0 / 720.0;                 // 1/6!
+  p = p * r2 - 1.0 / 24.0;                  // 1/4!
+  p = p * r2 + 0.5;                         // 1/2!
+  return 1.0 - p * r2;
+}
+
+/** @brief sin(r) for r in [-π/2, π/2]; Taylor series to r^23, truncation error < 1e-20. */
+template <typename T>
+inline auto sin_kernel(const T r) -> T {
+  const T r2 = r * r;
+  T p = T {} - 1.0 / 25852016738884976640000.0; // 1/23!
+  p = p * r2 + 1.0 / 51090942171709440000.0; // 1/21!
+  p = p * r2 - 1.0 / 121645100408832000.0;   // 1/19!
+  p = p * r2 + 1.0 / 355687428096000.0;      // 1/17!
+  p = p * r2 - 1.0 / 1307674368000.0;        // 1/15!
+  p = p * r2 + 1.0 / 6227020800.0;           // 1/13!
+  p = p * r2 - 1.0 / 39916800.0;             // 1/11!
+  p = p * r2 + 1.0 / 362880.0;               // 1/9!
+  p = p * r2 - 1.0 / 5040.0;                 // 1/7!
+  p = p * r2 + 1.0 / 120.0;                  // 1/5!
+  p = p * r2 - 1.0 / 6.0;                    // 1/3!
+  return r + r * (p * r2);
+}
+
+/**
+ * @brief Vector-friendly cosine.
+ * @param x The angle in radians, |x| < `MAX_TRIG_ARGUMENT`. `T` is `double` or `VecD`.
+ * @return cos(x), within `TRIG_ULP_BOUND` ULPs (of 1.0) of `std::cos`.
+ */
+template <typename T>
+inline auto cos(const T x) -> T {
+  const auto [r, sign] = reduce_pi(x);
+  return sign * cos_kernel(r);
+}
+
+/**
+ * @brief Vector-friendly sine.
+ * @param x The angle in radians, |x| < `MAX_TRIG_ARGUMENT`. `T` is `double` or `VecD`.
+ * @return sin(x), within `TRIG_ULP_BOUND` ULPs (of 1.0) of `std::sin`.
+ */
+template <typename T>
+inline auto sin(const T x) -> T {
+  const auto [r, sign] = reduce_pi(x);
+  return sign * sin_kernel(r);
+}
+
+/** @brief The documented bound of |simd::cos_narrow(x) - std::cos(x)|, i.e. a few ULPs of 1.0f. */
+constexpr double NARROW_COS_BOUND = 3e-7;
+
+/** @brief cos(r) for r in [-π/2, π/2], in single precision; Taylor series to r^12, truncation error < 7e-9. */
+template <typename T>
+inline auto cos_kernel_float(const T r) -> T {
+  const T r2 = r * r;
+  T p = T {} + 1.0F / 479001600.0F; // 1/12!
+  p = p * r2 - 1.0F / 3628800.0F;   // 1/10!
+  p = p * r2 + 1.0F / 40320.0F;     // 1/8!
+  p = p * r2 - 1.0F / 720.0F;       // 1/6!
+  p = p * r2 + 1.0F / 24.0F;        // 1/4!
+  p = p * r2 - 0.5F;                // 1/2!
+  return 1.0F + p * r2;
+}
+
+/**
+ * @brief Cosine of two vectors of doubles, evaluated in single precision on `FLOAT_LANES` lanes.
+ * @param lo The angles in radians of the lower half of the lanes, |x| < `MAX_TRIG_ARGUMENT`.
+ * @param hi The angles in radians of the upper half of the lanes, |x| < `MAX_TRIG_ARGUMENT`.
+ * @return cos(x), within `NARROW_COS_BOUND` of `std::cos`. Lane i is of `lo[i]`, and lane `LANES + i` is of `hi[i]`.
+ * @details The range reduction stays in double precision, since x can be ~1e5 radians, where a float has no fractional bits left.
+ *          The reduced angle and the polynomial, which make up most of the cost, are in single precision.
+ */
+inline auto cos_narrow(const VecD& lo, const VecD& hi) -> VecF {
+  // Same as `reduce_pi`, with a 2-part π, since r is rounded to a float anyway.
+  constexpr double PI_A   = 0x1.921fb54000000p+1;
+  constexpr double PI_B   = 0x1.10b4611a62633p-29;
+  constexpr double INV_PI = 0.318309886183790671537767526745; // 1/π
+
+  const VecD k_lo = round_nearest(lo * INV_PI);
+  const VecD k_hi = round_nearest(hi * INV_PI);
+  const VecF r = narrow((lo - k_lo * PI_A) - k_lo * PI_B, (hi - k_hi * PI_A) - k_hi * PI_B);
+
+  // (-1)^k, as in `reduce_pi`. The k's are integers below 2^23, so they are exact as floats.
+  constexpr float MAGIC = 12582912.0F; // 1.5 · 2^23
+  const VecF k = narrow(k_lo, k_hi);
+  const VecF parity = k - 2.0F * (((k * 0.5F) + MAGIC) - MAGIC);
+  const VecF sign = 1.0F - 2.0F * parity * parity;
+
+  return sign * cos_kernel_float(r);
+}
+
+/** @struct The result of `sincos`. */
+template <typename T>
+struct SinCos {
+  T sin;
+  T cos;
+};
+
+/**
+ * @brief Compute sin(x) and cos(x) together, sharing one range reduction.
+ * @param x The angle in radians, |x| < `MAX_TRIG_ARGUMENT`. `T` is `double` or `VecD`.
+ */
+template <typename T>
+inline auto sincos(const T x) -> SinCos<T> {
+  const auto [r, sign] = reduce_pi(x);
+  return { .sin = sign * sin_kernel(r), .cos = sign * cos_kernel(r) };
+}
+
+/** @brief Return the sine and cosine of (a + b), from those of a and b. `T` is `double` or `VecD`. */
+template <typename T>
+constexpr auto angle_sum(const SinCos<T>& a, const SinCos<T>& b) -> SinCos<T> {
+  return {
+    .sin = a.sin * b.cos + a.cos * b.sin,
+    .cos = a.cos * b.cos - a.sin * b.sin,
+  };
+}
+
+/** @struct The sines and cosines of k·x, for k in [-N, N], at index k + N. */
+template <typename T, int32_t N>
+struct Harmonics {
+  std::array<SinCos<T>, 2 * N + 1> values;
+
+  /** @brief Return the sine and cosine of k·x. */
+  [[nodiscard]] constexpr auto operator[](const int32_t k) const -> const SinCos<T>& {
+    return values[static_cast<std::size_t>(k + N)];
+  }
+};
+
+/**
+ * @brief Tabulate the sines and cosines of the multiples of an angle, which is cheaper than a `sincos` per multiple
+ *        when the multipliers of a series are small integers.
+ * @param first The sine and cosine of the angle x.
+ * @return The harmonics of x, with the angle-addition recurrences.
+ */
+template <int32_t N, typename T>
+inline auto make_harmonics(const SinCos<T>& first) -> Harmonics<T, N> {
+  constexpr auto ZERO = static_cast<std::size_t>(N); // The index of k = 0.
+
+  Harmonics<T, N> harmonics {};
+  harmonics.values[ZERO] = { .sin = T {} + 0.0, .cos = T {} + 1.0 };
+  for (std::size_t k = 1; k <= ZERO; ++k) {
+    // kx = (k - 1)x + x.
+    const SinCos<T>& previous = harmonics.values[ZERO + k - 1];
+    harmonics.values[ZERO + k] = angle_sum(previous, first);
+
+    // sin(-kx) = -sin(kx), and cos(-kx) = cos(kx).
+    harmonics.values[ZERO - k] = { .sin = -harmonics.values[ZERO + k].sin, .cos = harmonics.values[ZERO + k].cos };
+  }
+  return harmonics;
+}
+
+#pragma endregion
+
+} // namespace astro::simd
@@ -0,0 +1,338 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <format>
+#include <cstdint>
+#include <concepts>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace astro::solve {
+
+// Root finding for the moments of the astronomical events, e.g. the jieqis and the new moons.
+// The unknowns are JDEs (days), and the tolerances are given in seconds of time, see `Options`.
+// The functions are plain callables, so they are inlined into the solvers. A callable returns either
+// a `double`, or a `Sample` when its derivatives are known (e.g. from `apparent_with_rate`).
+
+
+/** @brief The seconds per day, to convert the tolerances to days. */
+constexpr double SECONDS_PER_DAY = 86400.0;
+
+
+/** @struct The value of a function at a point, and its derivatives. The unknown derivatives are NaN. */
+struct Sample {
+  double value;
+  double derivative = NAN;
+  double second_derivative = NAN;
+};
+
+/** @struct The options of the solvers. */
+struct Options {
+  double tolerance = 0.1;           // In seconds of time. See every solver for what it bounds.
+  std::size_t max_iterations = 30;  // The maximum number of steps.
+};
+
+/** @struct A closed interval which the iterates are kept in. Unbounded by default. */
+struct Interval {
+  double lower = -INFINITY;
+  double upper = INFINITY;
+
+  /** @brief Clamp the given point into the interval. */
+  [[nodiscard]] auto clamp(const double x) const -> double {
+    return std::clamp(x, lower, upper);
+  }
+};
+
+/** @struct The root, and the statistics of the iteration. */
+struct Result {
+  double root = NAN;            // The root, or the best estimate if not converged.
+  std::size_t iterations = 0;   // The number of steps taken.
+  std::size_t evaluations = 0;  // The number of calls of the function.
+  double last_step = NAN;       // The length of the last step, in days. 
+  bool converged = false;       // True if the tolerance was met within `max_iterations`.
+};
+
+
+/** @brief A function which returns its value only. */
+template <typename F>
+concept Function = requires(const F& f, const double x) {
+  { f(x) } -> std::convertible_to<double>;
+};
+
+/** @brief A function which returns its value and derivatives, see `Sample`. */
+template <typename F>
+concept DifferentiableFunction = requires(const F& f, const double x) {
+  { f(x) } -> std::same_as<Sample>;
+};
+
+/** @brief Return the value of the function at `x`, whether it returns a `Sample` or not. */
+template <typename F>
+requires Function<F> or DifferentiableFunction<F>
+inline auto value_at(const F& f, const double x) -> double {
+  if constexpr (DifferentiableFunction<F>) {
+    return f(x).value;
+  } else {
+    return f(x);
+  }
+}
+
+
+namespace detail {
+
+/** @brief Iterate `x += step(f(x))` from `x0`, until a step is shorter than the tolerance. */
+template <DifferentiableFunction F, typename Step>
+inline auto iterate(const F& f, const double x0, const Options& options, const Interval& interval, const Step& step) -> Result {
+  const double tolerance = options.tolerance / SECONDS_PER_DAY;
+
+  Result result { .root = interval.clamp(x0) };
+  while (result.iterations < options.max_iterations) {
+    const Sample sample = f(result.root);
+    ++result.evaluations;
+    ++result.iterations;
+
+    const double Δx = step(sample);
+    if (!std::isfinite(Δx)) [[unlikely]] { // E.g. a vanishing derivative.
+      break;
+    }
+
+    const double next = interval.clamp(result.root + Δx);
+    result.last_step = next - result.root;
+    result.root = next;
+
+    // The unclamped step is compared, so that a root beyond the interval does not look converged.
+    if (std::fabs(Δx) < tolerance) {
+      result.converged = true;
+      break;
+    }
+  }
+
+  return result;
+}
+
+} // namespace detail
+
+
+/**
+ * @brief Find a root by Newton's method.
+ * @param f The function, which returns its value and first derivative.
+ * @param x0 The initial guess.
+ * @param options The tolerance bounds the length of the last step. 
+ * @param interval The iterates are clamped into it. Unbounded by default.
+ * @return The root, and the statistics.
+ * @details The iteration stops after taking a step shorter than the tolerance. Newton's method converges quadratically, 
+ *          so the error after such a step is ~(f''/2f')·step², far below the tolerance once near the root.
+ */
+template <DifferentiableFunction F>
+inline auto newton(const F& f, const double x0, const Options& options = {}, const Interval& interval = {}) -> Result {
+  return detail::iterate(f, x0, options, interval, [](const Sample& s) {
+    return -s.value / s.derivative;
+  });
+}
+
+
+/**
+ * @brief Find a root by Halley's method.
+ * @param f The function, which returns its value and first and second derivatives. 
+ *          A NaN second derivative is taken as 0, i.e. the step is Newton's.
+ * @param x0 The initial guess.
+ * @param options The tolerance bounds the length of the last step. 
+ * @param interval The iterates are clamped into it. Unbounded by default.
+ * @return The root, and the statistics.
+ * @details Halley's method converges cubically, so it saves an iteration when the initial guess is far.
+ */
+template <DifferentiableFunction F>
+inline auto halley(const F& f, const double x0, const Options& options = {}, const Interval& interval = {}) -> Result {
+  return detail::iterate(f, x0, options, interval, [](const Sample& s) {
+    const double f2 = std::isnan(s.second_derivative) ? 0.0 : s.second_derivative;
+    return -2.0 * s.value * s.derivative / (2.0 * s.derivative * s.derivative - s.value * f2);
+  });
+}
+
+
+/**
+ * @brief Find a root in a bracket by the Illinois method, i.e. the false position with the stale end halved.
+ * @param f The function. Its derivatives are not used.
+ * @param lower The lower end of the bracket.
+ * @param upper The upper end of the bracket.
+ * @param options The tolerance bounds the width of the bracket, i.e. the error of the root.
+ * @return The root, and the statistics.
+ * @throw std::invalid_argument If `f` does not change its sign over the bracket.
+ * @details The bracket shrinks superlinearly (of order ~1.44), and the root never leaves it.
+ */
+template <typename F>
+requires Function<F> or DifferentiableFunction<F>
+inline auto illinois(const F& f, double lower, double upper, const Options& options = {}) -> Result {
+  const double tolerance = options.tolerance / SECONDS_PER_DAY;
+
+  double f_lower = value_at(f, lower);
+  double f_upper = value_at(f, upper);
+  Result result { .evaluations = 2 };
+
+  if (f_lower == 0.0 or f_upper == 0.0) {
+    result.root = f_lower == 0.0 ? lower : upper;
+    result.converged = true;
+    return result;
+  }
+  if (std::signbit(f_lower) == std::signbit(f_upper)) {
+    throw std::invalid_argument { std::format("No sign change between {} and {}.", lower, upper) };
+  }
+
+  int32_t side = 0; // The end replaced last time, -1 for the lower and 1 for the upper.
+  while (result.iterations < options.max_iterations) {
+    const double x = (lower * f_upper - upper * f_lower) / (f_upper - f_lower);
+    const double fx = value_at(f, x);
+    ++result.evaluations;
+    ++result.iterations;
+    result.last_step = std::isnan(result.root) ? NAN : x - result.root;
+    result.root = x;
+
+    if (fx == 0.0) {
+      result.converged = true;
+      break;
+    }
+
+    if (std::signbit(fx) == std::signbit(f_lower)) {
+      lower = x;
+      f_lower = fx;
+      if (side == -1) { f_upper /= 2.0; }
+      side = -1;
+    } else {
+      upper = x;
+      f_upper = fx;
+      if (side == 1) { f_lower /= 2.0; }
+      side = 1;
+    }
+
+    if (upper - lower < tolerance) {
+      result.converged = true;
+      break;
+    }
+  }
+
+  return result;
+}
+
+
+/**
+ * @brief Find a root in a bracket by Newton's method, safeguarded by the Illinois method.
+ * @param f The function, which returns its value and first derivative.
+ * @param lower The lower end of the bracket.
+ * @param upper The upper end of the bracket.
+ * @param f_lower The value of `f` at `lower`, e.g. already evaluated by the caller to check the bracket.
+ * @param f_upper The value of `f` at `upper`.
+ * @param options The tolerance bounds the length of the last step, or the width of the bracket.
+ * @return The root, and the statistics. The evaluations at the ends are not counted.
+ * @throw std::invalid_argument If `f` does not change its sign over the bracket.
+ * @details The first guess is the false position of the bracket. Every evaluation shrinks the bracket, 
+ *          and a Newton step which leaves it is replaced by an Illinois step. So the convergence is quadratic 
+ *          near the root, and guaranteed from anywhere in the bracket.
+ */
+template <DifferentiableFunction F>
+inline auto bracketed_newton(
+  const F& f, 
+  double lower, 
+  double upper,             // NOLINT(bugprone-easily-swappable-parameters)
+  double f_lower, 
+  double f_upper, 
+  const Options& options = {}
+) -> Result {
+  const double tolerance = options.tolerance / SECONDS_PER_DAY;
+
+  Result result {};
+
+  if (f_lower == 0.0 or f_upper == 0.0) {
+    result.root = f_lower == 0.0 ? lower : upper;
+    result.converged = true;
+    return result;
+  }
+  if (std::signbit(f_lower) == std::signbit(f_upper)) {
+    throw std::invalid_argument { std::format("No sign change between {} and {}.", lower, upper) };
+  }
+
+  int32_t side = 0; // The end replaced last time, -1 for the lower and 1 for the upper.
+  double x = (lower * f_upper - upper * f_lower) / (f_upper - f_lower);
+  while (result.iterations < options.max_iterations) {
+    const Sample sample = f(x);
+    ++result.evaluations;
+    ++result.iterations;
+
+    if (sample.value == 0.0) {
+      result.root = x;
+      result.converged = true;
+      break;
+    }
+
+    // Shrink the bracket, and halve the stale end for the Illinois step.
+    if (std::signbit(sample.value) == std::signbit(f_lower)) {
+      lower = x;
+      f_lower = sample.value;
+      if (side == -1) { f_upper /= 2.0; }
+      side = -1;
+    } else {
+      upper = x;
+      f_upper = sample.value;
+      if (side == 1) { f_lower /= 2.0; }
+      side = 1;
+    }
+
+    const double newton_x = x - sample.value / sample.derivative;
+    const double next = lower < newton_x and newton_x < upper 
+                      ? newton_x 
+                      : (lower * f_upper - upper * f_lower) / (f_upper - f_lower);
+
+    result.last_step = next - x;
+    result.root = next;
+    x = next;
+
+    if (std::fabs(result.last_step) < tolerance or upper - lower < tolerance) {
+      result.converged = true;
+      break;
+    }
+  }
+
+  return result;
+}
+
+
+/**
+ * @brief Find a root in a bracket by Newton's method, safeguarded by the Illinois method.
+ * @param f The function, which returns its value and first derivative.
+ * @param lower The lower end of the bracket.
+ * @param upper The upper end of the bracket.
+ * @param options The tolerance bounds the length of the last step, or the width of the bracket.
+ * @return The root, and the statistics.
+ * @throw std::invalid_argument If `f` does not change its sign over the bracket.
+ * @details Evaluates `f` at the ends, see the overload which takes their values.
+ */
+template <DifferentiableFunction F>
+inline auto bracketed_newton(const F& f, const double lower, const double upper, const Options& options = {}) -> Result {
+  Result result = bracketed_newton(f, lower, upper, f(lower).value, f(upper).value, options);
+  result.evaluations += 2;
+  return result;
+}
+
+} // namespace astro::solve
@@ -23,11 +23,19 @@
 
 #pragma once
 
-#include <numbers>
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <format>
+#include <algorithm>
+#include <stdexcept>
 
 #include "toolbox.hpp"
 #include "julian_day.hpp"
 #include "earth.hpp"
+#include "epoch.hpp"
+#include "ephemeris.hpp"
+#include "solve.hpp"
 
 namespace astro::sun::geocentric_coord {
 
@@ -35,17 +43,17 @@ using astro::toolbox::Angle;
 using astro::toolbox::AngleUnit::DEG;
 using astro::toolbox::AngleUnit::RAD;
 using astro::toolbox::SphericalCoordinate;
+using astro::toolbox::SphericalCoordinateWithRate;
+using astro::vsop87d::Precision;
 
 
 /**
- * @brief Calculate the geocentric position of the Sun, using VSOP87D.
- * @param jde The Julian Ephemeris Day.
- * @return The geocentric ecliptic position of the Sun, calculated using VSOP87D.
- * @details The function invokes `astro::earth::heliocentric_coord::vsop87d`, and
- *          transforms the heliocentric coordinates to geocentric coordinates.
+ * @brief Convert the heliocentric position of the Earth to the geocentric position of the Sun.
+ * @param earth_coord The heliocentric ecliptic position of the Earth.
+ * @return The geocentric ecliptic position of the Sun.
  */
-inline auto vsop87d(const double jde) -> SphericalCoordinate {
-  const auto& [λ_helio, β_helio, r_helio] = astro::earth::heliocentric_coord::vsop87d(jde);
+inline auto from_heliocentric(const SphericalCoordinate& earth_coord) -> SphericalCoordinate {
+  const auto& [λ_helio, β_helio, r_helio] = earth_coord;
   return {
     // Convert the heliocentric ecliptic longitude of Earth to geocentric ecliptic longitude of Sun.
     // The formula is: λ_sun_geocentric_deg = λ_earth_heliocentric_deg + 180∘
@@ -65,6 +73,72 @@ inline auto vsop87d(const double jde) -> SphericalCoordinate {
 }
 
 
+/**
+ * @brief Calculate the geocentric position of the Sun, using VSOP87D.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The Julian Ephemeris Day.
+ * @return The geocentric ecliptic position of the Sun, calculated using VSOP87D.
+ * @details The function invokes `astro::earth::heliocentric_coord::vsop87d`, and
+ *          transforms the heliocentric coordinates to geocentric coordinates.
+ */
+template <Precision precision = Precision::FULL>
+inline auto vsop87d(const double jde) -> SphericalCoordinate {
+  return from_heliocentric(astro::earth::heliocentric_coord::vsop87d<precision>(jde));
+}
+
+
+/**
+ * @brief Calculate the geocentric position of the Sun and its time derivatives, using VSOP87D.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The Julian Ephemeris Day.
+ * @return The same position as `vsop87d`, and the rates in degrees/day and AU/day.
+ */
+template <Precision precision = Precision::FULL>
+inline auto vsop87d_with_rate(const double jde) -> SphericalCoordinateWithRate {
+  const auto [earth_coord, earth_rate] = astro::earth::heliocentric_coord::vsop87d_with_rate<precision>(jde);
+  return {
+    .coord = from_heliocentric(earth_coord),
+    .rate = { .λ = earth_rate.λ, .β = -earth_rate.β, .r = earth_rate.r },
+  };
+}
+
+
+/**
+ * @brief Calculate the geocentric positions of the Sun for many JDEs, using VSOP87D.
+ * @param jdes The julian ephemeris day numbers.
+ * @return The geocentric ecliptic positions of the Sun, one per JDE, in the same order.
+ * @details Same results as calling `vsop87d` on every JDE, see `astro::earth::heliocentric_coord::vsop87d_batch`.
+ */
+inline auto vsop87d_batch(const std::span<const double> jdes) -> std::vector<SphericalCoordinate> {
+  using namespace std::ranges;
+  return astro::earth::heliocentric_coord::vsop87d_batch(jdes) 
+       | views::transform(from_heliocentric) 
+       | to<std::vector>();
+}
+
+
+/**
+ * @brief Calculate the geocentric positions of the Sun on evenly spaced JDEs, using VSOP87D.
+ * @param start_jde The first julian ephemeris day number.
+ * @param step The spacing between two consecutive JDEs, in days.
+ * @param count The number of JDEs.
+ * @param options The re-seed interval and the error budget of the stepper.
+ * @return The geocentric ecliptic positions of the Sun at `start_jde + i * step`, for i in [0, count).
+ * @details See `astro::earth::heliocentric_coord::vsop87d_grid`.
+ */
+inline auto vsop87d_grid(
+  const double start_jde, 
+  const double step, 
+  const std::size_t count, 
+  const astro::vsop87d::StepperOptions options = {}
+) -> std::vector<SphericalCoordinate> {
+  using namespace std::ranges;
+  return astro::earth::heliocentric_coord::vsop87d_grid(start_jde, step, count, options) 
+       | views::transform(from_heliocentric) 
+       | to<std::vector>();
+}
+
+
 /** @brief The FK5 correction for the coordinate calculated using VSOP87D. */
 struct Fk5Correction {
   const Angle<DEG> Δλ;
@@ -97,21 +171,21 @@ inline auto fk5_correction(const double jde, const SphericalCoordinate& vsop87d_
 
 
 /**
- * @brief Calculate the apparent geocentric position of the Sun, using VSOP87D. 
+ * @brief Correct the geocentric position of the Sun calculated by VSOP87D, to the apparent position.
  *        The position is corrected to FK5 system, considering nutation and aberration. 
  * @param jde The julian ephemeris day number, which is based on TT.
+ * @param vsop_coord The geocentric ecliptic position of the Sun at `jde`, as returned by `vsop87d`.
+ * @param nutation The Earth's nutation in longitude (Δψ) at `jde`.
  * @return The geocentric ecliptic position of the Sun, after correction.
  */
-inline auto apparent(const double jde) -> SphericalCoordinate {
-  // Use VSOP87D to calculate the geocentric ecliptic position of the Sun.
-  const auto vsop_coord = vsop87d(jde);
-
+inline auto apparent_from_vsop87d(
+  const double jde, 
+  const SphericalCoordinate& vsop_coord, 
+  const Angle<DEG> nutation
+) -> SphericalCoordinate {
   // Calculate the correction for the VSIO87D result, in order to convert it to FK5 system.
   const auto correction = fk5_correction(jde, vsop_coord);
 
-  // Calculate the Earth's nutation in longtitude.
-  const auto nutation = astro::earth::nutation::longitude(jde);
-
   // Calculate the Solar aberration.
   const auto aberration = astro::earth::aberration::compute(vsop_coord.r.au());
 
@@ -128,6 +202,209 @@ inline auto apparent(const double jde) -> SphericalCoordinate {
   };
 }
 
+
+/**
+ * @brief Correct the geocentric position of the Sun calculated by VSOP87D, to the apparent position.
+ *        The position is corrected to FK5 system, considering nutation and aberration. 
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param vsop_coord The geocentric ecliptic position of the Sun at `jde`, as returned by `vsop87d`.
+ * @return The geocentric ecliptic position of the Sun, after correction.
+ */
+inline auto apparent_from_vsop87d(const double jde, const SphericalCoordinate& vsop_coord) -> SphericalCoordinate {
+  return apparent_from_vsop87d(jde, vsop_coord, astro::earth::nutation::longitude(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Sun, using VSOP87D. 
+ *        The position is corrected to FK5 system, considering nutation and aberration. 
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ *                   The tier's tolerance applies to the result, since the corrections are evaluated in full.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The geocentric ecliptic position of the Sun, after correction.
+ */
+template <Precision precision = Precision::FULL>
+inline auto apparent(const double jde) -> SphericalCoordinate {
+  // Use VSOP87D to calculate the geocentric ecliptic position of the Sun, and then correct it.
+  return apparent_from_vsop87d(jde, vsop87d<precision>(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Sun, with the nutation interpolated.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param nutation The nutation interpolator, see `astro::earth::nutation::NutationInterpolator`.
+ * @return The same position as `apparent`, within the interpolator's error bound.
+ */
+template <Precision precision = Precision::FULL>
+inline auto apparent(const double jde, const astro::earth::nutation::NutationInterpolator& nutation) -> SphericalCoordinate {
+  return apparent_from_vsop87d(jde, vsop87d<precision>(jde), nutation.longitude(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Sun, with the nutation of a shared epoch context.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param ctx The context of the epoch, see `astro::epoch::make_context`.
+ * @return The same position as `apparent`, when `ctx` uses the default nutation model.
+ */
+template <Precision precision = Precision::FULL>
+inline auto apparent(const astro::epoch::EpochContext& ctx) -> SphericalCoordinate {
+  return apparent_from_vsop87d(ctx.jde, vsop87d<precision>(ctx.jde), ctx.nutation.Δψ);
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Sun and its time derivatives, with the given nutation.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param nutation The nutation and its rates at `jde`, see `nutation::compute_with_rate`.
+ * @return The same position as `apparent`, and the rates in degrees/day and AU/day.
+ * @details The VSOP87D part, which dominates the cost, is differentiated in closed form, in the same pass as the position.
+ *          The rates of the aberration and the FK5 correction follow from the rates of r and λ.
+ */
+template <Precision precision = Precision::FULL>
+inline auto apparent_with_rate(
+  const double jde, 
+  const astro::earth::nutation::NutationWithRate& nutation
+) -> SphericalCoordinateWithRate {
+  const auto [vsop_coord, vsop_rate] = vsop87d_with_rate<precision>(jde);
+  const double nutation_rate = nutation.Δψ_rate;
+
+  // The aberration is k/r, so its rate is -k·(dr/dt)/r².
+  const double r = vsop_coord.r.au();
+  const double aberration_rate = astro::earth::aberration::compute(r).deg() * -vsop_rate.r / r;
+
+  // Δβ of the FK5 correction is 0".03916·(cos(λ') - sin(λ')), where λ' moves with λ.
+  // The rate of Δλ is scaled by tan(β), and negligible.
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  const double λ_dash_rad = (vsop_coord.λ - Angle<DEG> { (1.397 + 0.00031 * jc) * jc }).rad();
+  const double fk5_β_rate = Angle<DEG>::from_arcsec(
+    -0.03916 * (sin(λ_dash_rad) + cos(λ_dash_rad)) * astro::toolbox::deg_to_rad(vsop_rate.λ)
+  ).deg();
+
+  return {
+    .coord = apparent_from_vsop87d(jde, vsop_coord, nutation.value.Δψ),
+    .rate = {
+      .λ = vsop_rate.λ + nutation_rate - aberration_rate,
+      .β = vsop_rate.β + fk5_β_rate,
+      .r = vsop_rate.r,
+    },
+  };
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric position of the Sun and its time derivatives.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The same position as `apparent`, and the rates in degrees/day and AU/day.
+ * @details The nutation and its rate come from one pass over the nutation terms, see `nutation::compute_with_rate`.
+ */
+template <Precision precision = Precision::FULL>
+inline auto apparent_with_rate(const double jde) -> SphericalCoordinateWithRate {
+  return apparent_with_rate<precision>(jde, astro::earth::nutation::compute_with_rate(jde));
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric positions of the Sun for many JDEs. 
+ * @param jdes The julian ephemeris day numbers.
+ * @return The geocentric ecliptic positions of the Sun, after correction, one per JDE, in the same order.
+ * @details Same results as calling `apparent` on every JDE. The VSOP87D part, which dominates the cost, is batched.
+ */
+inline auto apparent_batch(const std::span<const double> jdes) -> std::vector<SphericalCoordinate> {
+  const auto vsop_coords = vsop87d_batch(jdes);
+
+  std::vector<SphericalCoordinate> results;
+  results.reserve(jdes.size());
+  for (std::size_t i = 0; i < jdes.size(); ++i) {
+    results.emplace_back(apparent_from_vsop87d(jdes[i], vsop_coords[i]));
+  }
+  return results;
+}
+
+
+/**
+ * @brief Calculate the apparent geocentric positions of the Sun on evenly spaced JDEs.
+ * @param start_jde The first julian ephemeris day number.
+ * @param step The spacing between two consecutive JDEs, in days.
+ * @param count The number of JDEs.
+ * @param options The re-seed interval and the error budget of the VSOP87D stepper.
+ * @return The geocentric ecliptic positions of the Sun, after correction, at `start_jde + i * step`, for i in [0, count).
+ * @details The VSOP87D part is evaluated with `vsop87d_grid`, the corrections are the same as `apparent`.
+ */
+inline auto apparent_grid(
+  const double start_jde, 
+  const double step, 
+  const std::size_t count, 
+  const astro::vsop87d::StepperOptions options = {}
+) -> std::vector<SphericalCoordinate> {
+  const auto vsop_coords = vsop87d_grid(start_jde, step, count, options);
+
+  std::vector<SphericalCoordinate> results;
+  results.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const double jde = start_jde + static_cast<double>(i) * step;
+    results.emplace_back(apparent_from_vsop87d(jde, vsop_coords[i]));
+  }
+  return results;
+}
+
+
+
+// The apparent positions can also be looked up in a precomputed Chebyshev ephemeris (see `astro::ephemeris`),
+// which is much cheaper than VSOP87D. Once an ephemeris is in use, the root finders in `math` use it transparently
+// for the JDEs it covers, and fall back to `apparent` elsewhere.
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+inline std::mutex EPHEMERIS_MUTEX;
+inline std::shared_ptr<const astro::ephemeris::Ephemeris> ACTIVE_EPHEMERIS;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+
+/**
+ * @brief Fit `apparent` and write the Chebyshev ephemeris file.
+ * @param path The path of the file to write.
+ * @param start_jde The start of the coverage.
+ * @param end_jde The end of the coverage. Rounded up to a whole number of granules.
+ * @param options The granule length and the numbers of coefficients.
+ * @throw std::invalid_argument If the range or the options are invalid.
+ * @throw std::runtime_error If the file cannot be written.
+ */
+inline void generate_ephemeris(
+  const std::string& path, 
+  const double start_jde, 
+  const double end_jde, 
+  const astro::ephemeris::GenerateOptions& options = {}
+) {
+  astro::ephemeris::generate(path, start_jde, end_jde, apparent_batch, options);
+}
+
+/**
+ * @brief Load the ephemeris file, and use it in the root finders from now on.
+ * @param path The path of the file, written by `generate_ephemeris`.
+ * @throw std::runtime_error If the file is invalid. The ephemeris in use (if any) is kept in this case.
+ */
+inline void use_ephemeris(const std::string& path) {
+  auto ephemeris = std::make_shared<const astro::ephemeris::Ephemeris>(path);
+  const std::lock_guard lock { EPHEMERIS_MUTEX };
+  ACTIVE_EPHEMERIS = std::move(ephemeris);
+}
+
+/** @brief Stop using the ephemeris, i.e. the root finders evaluate `apparent` again. */
+inline void clear_ephemeris() {
+  const std::lock_guard lock { EPHEMERIS_MUTEX };
+  ACTIVE_EPHEMERIS.reset();
+}
+
+/** @brief Return the ephemeris in use, or `nullptr` if there is none. */
+inline auto active_ephemeris() -> std::shared_ptr<const astro::ephemeris::Ephemeris> {
+  const std::lock_guard lock { EPHEMERIS_MUTEX };
+  return ACTIVE_EPHEMERIS;
+}
+
 } // namespace astro::sun::geocentric_coord
 
 
@@ -153,19 +430,121 @@ namespace astro::sun::geocentric_coord::math {
  */
 
 
+/** @brief A snapshot of the ephemeris in use, see `active_ephemeris`. Taken once per solve, so it is not locked per evaluation. */
+using EphemerisSnapshot = std::shared_ptr<const astro::ephemeris::Ephemeris>;
+
 /**
  * @brief Calculate the apparent geocentric longitude of the Sun.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ *                   With `Precision::FULL`, the given ephemeris is looked up when it covers the JDE.
  * @param jde The julian ephemeris day number, which is based on TT.
+ * @param ephemeris The ephemeris to look up, or `nullptr` to always evaluate `apparent`.
  * @return The apparent geocentric longitude of the Sun in degrees.
  */
-inline auto solar_longitude(const double jde) -> double {
+template <Precision precision = Precision::FULL>
+inline auto solar_longitude(const double jde, [[maybe_unused]] const astro::ephemeris::Ephemeris* ephemeris) -> double {
+  // Look up the ephemeris, if there is one and it covers the JDE.
+  if constexpr (precision == Precision::FULL) {
+    if (ephemeris != nullptr and ephemeris->covers(jde)) {
+      return ephemeris->lookup(jde).λ.deg();
+    }
+  }
+
   // Calculate the apparent geocentric longitude of the Sun.
-  const auto coord = astro::sun::geocentric_coord::apparent(jde);
+  const auto coord = astro::sun::geocentric_coord::apparent<precision>(jde);
 
   // Return in degrees.
   return coord.λ.deg();
 }
 
+/**
+ * @brief Calculate the apparent geocentric longitude of the Sun.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ *                   With `Precision::FULL`, the ephemeris in use (see `use_ephemeris`) is looked up when it covers the JDE.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The apparent geocentric longitude of the Sun in degrees.
+ */
+template <Precision precision = Precision::FULL>
+inline auto solar_longitude(const double jde) -> double {
+  if constexpr (precision == Precision::FULL) {
+    const EphemerisSnapshot ephemeris = astro::sun::geocentric_coord::active_ephemeris();
+    return solar_longitude<precision>(jde, ephemeris.get());
+  } else {
+    return solar_longitude<precision>(jde, nullptr);
+  }
+}
+
+/** @brief The mean motion of the Sun in longitude, in degrees/day, i.e. 360° per tropical year. */
+constexpr double MEAN_MOTION = 0.98564736;
+
+/**
+ * @brief Calculate the apparent geocentric longitude of the Sun, with low accuracy.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The apparent geocentric longitude of the Sun in degrees, not normalized. Accurate to ~0.01° near J2000.
+ * @ref Jean Meeus, "Astronomical Algorithms", Second Edition, Chapter 25, Formulas (25.2) to (25.4), and "apparent" λ.
+ */
+inline auto low_accuracy_longitude(const double jde) -> double {
+  const double jc = astro::julian_day::jde_to_jc(jde);
+
+  // The geometric mean longitude, and the mean anomaly of the Sun.
+  const double L0 = 280.46646 + jc * (36000.76983 + jc * 0.0003032);
+  const double M  = astro::toolbox::deg_to_rad(357.52911 + jc * (35999.05029 - jc * 0.0001537));
+
+  // The equation of the center.
+  const double C = (1.914602 - jc * (0.004817 + jc * 0.000014)) * std::sin(M)
+                 + (0.019993 - jc * 0.000101) * std::sin(2.0 * M)
+                 + 0.000289 * std::sin(3.0 * M);
+
+  // Corrected for the nutation and the aberration.
+  const double Ω = astro::toolbox::deg_to_rad(125.04 - 1934.136 * jc);
+  return L0 + C - 0.00569 - 0.00478 * std::sin(Ω);
+}
+
+
+/** @brief The span of `low_accuracy_longitude` to classify with, in julian centuries from J2000, i.e. the years -1000 to 5000. */
+constexpr double LOW_ACCURACY_SPAN = 30.0;
+
+/** @brief The tolerance of `low_accuracy_longitude` within `LOW_ACCURACY_SPAN`, in degrees. The error measured is below 0.014°. */
+constexpr double LOW_ACCURACY_TOLERANCE = 0.03;
+
+/**
+ * @brief Return true if the low accuracy longitude is farther than its tolerance from the given threshold,
+ *        so it falls on the same side of the threshold as the apparent longitude does.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param low_lon The low accuracy longitude at `jde`, in degrees, see `low_accuracy_longitude`.
+ * @param threshold The threshold, in degrees. Compared on the circle, so 0° stands for 360° as well.
+ */
+inline auto low_accuracy_clear_of(const double jde, const double low_lon, const double threshold) -> bool {
+  if (std::abs(astro::julian_day::jde_to_jc(jde)) > LOW_ACCURACY_SPAN) {
+    return false;
+  }
+  return std::abs(astro::toolbox::normalize_pm180(low_lon - threshold)) > LOW_ACCURACY_TOLERANCE;
+}
+
+/**
+ * @brief Return the apparent solar longitude to classify `lon` with, i.e. to compare `lon` with.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param low_lon The low accuracy longitude at `jde`, normalized to [0, 360), see `low_accuracy_longitude`.
+ * @param lon The longitude to classify, in degrees.
+ * @param ephemeris The ephemeris to look up, see `solar_longitude`.
+ * @return `low_lon` when it is clear of both `lon` and the wrap at 0°, so the comparisons agree with the apparent longitude.
+ *         Otherwise, the apparent longitude by `solar_longitude`.
+ */
+template <Precision precision = Precision::FULL>
+inline auto guarded_longitude(
+  const double jde, 
+  const double low_lon, 
+  const double lon, 
+  const astro::ephemeris::Ephemeris* ephemeris
+) -> double {
+  if (low_accuracy_clear_of(jde, low_lon, lon) and low_accuracy_clear_of(jde, low_lon, 0.0)) {
+    return low_lon;
+  }
+  return solar_longitude<precision>(jde, ephemeris);
+}
+
+
 /** @brief Return the JDE of the start of the year. */
 inline auto get_start_jde(const int32_t year) -> double{
   return astro::julian_day::ut1_to_jde(calendar::Datetime { util::to_ymd(year, 1, 1), 0.0 });
@@ -177,37 +556,90 @@ inline auto get_end_jde(const int32_t year) -> double {
 }
 
 /** @brief Return the apparent geocentric longitude of the Sun at the start of the year. */
+template <Precision precision = Precision::FULL>
 inline auto get_start_lon(const int32_t year) -> double {
-  return solar_longitude(get_start_jde(year));
+  return solar_longitude<precision>(get_start_jde(year));
 }
 
 /** @brief Return the apparent geocentric longitude of the Sun at the end of the year. */
+template <Precision precision = Precision::FULL>
 inline auto get_end_lon(const int32_t year) -> double {
-  return solar_longitude(get_end_jde(year));
+  return solar_longitude<precision>(get_end_jde(year));
+}
+
+/** @struct The bounds of a year, and the low accuracy solar longitudes there, in degrees. */
+struct YearBounds {
+  double start_jde; // The start of the year, inclusive.
+  double end_jde;   // The end of the year, exclusive.
+  double start_lon; // The low accuracy solar longitude at `start_jde`, normalized, see `low_accuracy_longitude`.
+  double end_lon;   // The low accuracy solar longitude at `end_jde`, normalized, see `low_accuracy_longitude`.
+  EphemerisSnapshot ephemeris; // The ephemeris in use when the bounds are evaluated, for the solves in the year.
+
+  /** @brief Clamp the given JDE to [start_jde, end_jde). */
+  [[nodiscard]] auto clamp(const double jde) const -> double {
+    return std::clamp(jde, start_jde, std::nextafter(end_jde, start_jde));
+  }
+};
+
+/** @brief Evaluate the bounds of the given year, and the low accuracy solar longitudes there. Snapshots the ephemeris in use. */
+inline auto year_bounds(const int32_t year) -> YearBounds {
+  const double start_jde = get_start_jde(year);
+  const double end_jde = get_end_jde(year);
+  return {
+    .start_jde = start_jde,
+    .end_jde   = end_jde,
+    .start_lon = astro::toolbox::normalize_deg(low_accuracy_longitude(start_jde)),
+    .end_lon   = astro::toolbox::normalize_deg(low_accuracy_longitude(end_jde)),
+    .ephemeris = astro::sun::geocentric_coord::active_ephemeris(),
+  };
 }
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
 
+// The roots are classified by the low accuracy longitudes of `YearBounds`, which cost no VSOP87D evaluation. 
+// Only when `lon` is within `LOW_ACCURACY_TOLERANCE` of one of them, the apparent longitude there is evaluated, 
+// see `guarded_longitude`. So the classification agrees with the one by `get_start_lon` and `get_end_lon`.
+
+/** @brief Return true if the year of the given bounds has a root for the given `lon` before the spring equinox. */
+template <Precision precision = Precision::FULL>
+inline auto has_root_before_spring_equinox(const YearBounds& bounds, const double lon) -> bool {
+  const double start_lon = guarded_longitude<precision>(bounds.start_jde, bounds.start_lon, lon, bounds.ephemeris.get());
+  return start_lon <= lon and lon < 360.0;
+}
+
+/** @brief Return true if the year of the given bounds has a root for the given `lon` after the spring equinox. */
+template <Precision precision = Precision::FULL>
+inline auto has_root_after_spring_equinox(const YearBounds& bounds, const double lon) -> bool {
+  const double end_lon = guarded_longitude<precision>(bounds.end_jde, bounds.end_lon, lon, bounds.ephemeris.get());
+  return 0.0 <= lon and lon < end_lon;
+}
+
 /** @brief Return true if the given year has a root for the given `lon` before the spring equinox. */
+template <Precision precision = Precision::FULL>
 inline auto has_root_before_spring_equinox(const int32_t year, const double lon) -> bool {
-  const double start_lon = get_start_lon(year);
-  return start_lon <= lon and lon < 360.0;
+  return has_root_before_spring_equinox<precision>(year_bounds(year), lon);
 }
 
 /** @brief Return true if the given year has a root for the given `lon` after the spring equinox. */
+template <Precision precision = Precision::FULL>
 inline auto has_root_after_spring_equinox(const int32_t year, const double lon) -> bool {
-  const double end_lon = get_end_lon(year);
-  return 0.0 <= lon and lon < end_lon;
+  return has_root_after_spring_equinox<precision>(year_bounds(year), lon);
 }
 
-/** @brief Return the count of the roots for the given `year` and `lon`. */
+/** 
+ * @brief Return the count of the roots for the given `year` and `lon`. 
+ * @tparam precision The precision tier of VSOP87D. With a cheaper tier, the count can be off 
+ *                   when `lon` is within the tier's tolerance of the Sun's longitude at the start or the end of the year.
+ */
+template <Precision precision = Precision::FULL>
 inline auto discriminant(const int32_t year, const double lon) -> uint32_t {
+  const auto bounds = year_bounds(year);
   uint32_t count = 0;
 
-  if (has_root_before_spring_equinox(year, lon)) {
+  if (has_root_before_spring_equinox<precision>(bounds, lon)) {
     count++;
   }
-  if (has_root_after_spring_equinox(year, lon)) {
+  if (has_root_after_spring_equinox<precision>(bounds, lon)) {
     count++;
   }
 
@@ -215,161 +647,169 @@ inline auto discriminant(const int32_t year, const double lon) -> uint32_t {
 }
 
 
-// In Newton's method, we will approximate the root with the previous root, iteratively.
-// The formula is: Xn+1 = Xn - f(Xn) / f'(Xn).
-// Where we can use the following formula to approximate f'(x):
-// f'(x) = (f(x+h) - f(x-h)) / (2*h), where h is a small number, usally [1e-8, 1e-5].
-//
-// As mentioned before, our goal is to find the root (JDE) at which the Sun reaches the expected longitude in a given year.
-// In our context, f is defined as:
-// f(jde) = solar_longitude(jde) - expected_lon,
-// and f is defined on a half-open interval [start_jde(year), end_jde(year)).
-//
-// Newton's method requires f to be differentiable (smooth).
-// So we need to modify the function of `solar_longitude`.
-// Bacause the beginning position of Sun in a year is roughly 280.0 degrees, and we need to make it negative.
-// Actually, for any JDE befire Spring Equinox this year, we need to substract 360 from `solar_longitude`'s result to make f smooth.
-// 
-// So the actual f is defined as:
-// f(jde) = modified_solar_longitude(jde) - expected_lon
+// The roots are found as follows, see `find_roots`.
+// 1. The bounds of the year are evaluated once, and the roots are classified by the low accuracy longitudes there.
+// 2. The root is seeded by the low accuracy solar longitude of Meeus's Chapter 25, to within ~0.02 day.
+// 3. Newton's method uses the closed-form rate of `apparent_with_rate`, so every iteration evaluates the Sun once,
+//    and it converges quadratically: 2 iterations from the seed, typically.
 
-using FuncType = std::function<double(const double)>;
 
-/**@brief Return a `f` that we can apply Newton's method to. */
-inline auto make_f(const int32_t year, const double expected_lon) -> FuncType {
-  const double apr_1st_jde = astro::julian_day::ut1_to_jde(calendar::Datetime { util::to_ymd(year, 4, 1), 0.0 });
+/**
+ * @brief Calculate the apparent geocentric longitude of the Sun, and its rate.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ *                   With `Precision::FULL`, the given ephemeris is looked up when it covers the JDE.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param ephemeris The ephemeris to look up, or `nullptr` to always evaluate `apparent_with_rate`.
+ * @return The same longitude as `solar_longitude` in degrees, and its rate in degrees/day.
+ */
+template <Precision precision = Precision::FULL>
+inline auto solar_longitude_with_rate(
+  const double jde, 
+  [[maybe_unused]] const astro::ephemeris::Ephemeris* ephemeris
+) -> std::pair<double, double> {
+  // The ephemeris is differentiated by a central difference, since its lookups are cheap.
+  if constexpr (precision == Precision::FULL) {
+    if (ephemeris != nullptr and ephemeris->covers(jde - 1e-3) and ephemeris->covers(jde + 1e-3)) {
+      const double Δλ = ephemeris->lookup(jde + 1e-3).λ.deg() - ephemeris->lookup(jde - 1e-3).λ.deg();
+      return { ephemeris->lookup(jde).λ.deg(), astro::toolbox::normalize_pm180(Δλ) / 2e-3 };
+    }
+  }
 
-  const auto modified_solar_longitude = [=](const double jde) -> double {
-    const double raw_value = solar_longitude(jde);
+  const auto [coord, rate] = astro::sun::geocentric_coord::apparent_with_rate<precision>(jde);
+  return { coord.λ.deg(), rate.λ };
+}
 
-    // We mostly want to substract 360.0 from those JDEs before Spring Equinox.
-    //
-    // We are here using the fact that the beginning of the year is roughly 280.0 degrees,
-    // and it continues growing to 360 degrees (which is also 0 degrees) until Spring Equinox.
-    // 
-    // After Spring Equinox, it grows from 0 to ~280.0 degrees again (the last day of the year), 
-    // and then next year comes.
+/**
+ * @brief Calculate the apparent geocentric longitude of the Sun, and its rate.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ *                   With `Precision::FULL`, the ephemeris in use (see `use_ephemeris`) is looked up when it covers the JDE.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @return The same longitude as `solar_longitude` in degrees, and its rate in degrees/day.
+ */
+template <Precision precision = Precision::FULL>
+inline auto solar_longitude_with_rate(const double jde) -> std::pair<double, double> {
+  if constexpr (precision == Precision::FULL) {
+    const EphemerisSnapshot ephemeris = astro::sun::geocentric_coord::active_ephemeris();
+    return solar_longitude_with_rate<precision>(jde, ephemeris.get());
+  } else {
+    return solar_longitude_with_rate<precision>(jde, nullptr);
+  }
+}
 
-    if (jde < apr_1st_jde and raw_value >= 250.0) {
-      return raw_value - 360.0;
-    }
 
-    return raw_value; 
-  };
+/**
+ * @brief Estimate the JDE when the Sun has travelled the given longitude since an anchor.
+ * @param anchor_jde The JDE of the anchor, e.g. the start of the year, or a root found already.
+ * @param anchor_lon The apparent solar longitude at `anchor_jde`, in degrees.
+ * @param travelled The longitude travelled by the Sun since the anchor, in degrees, in [0, 360].
+ * @return The estimated JDE. Within ~0.01 day, and closer when the anchor is near.
+ * @details The mean motion picks the revolution, and the low accuracy longitude is then inverted by a few fixed-point steps.
+ *          Every step shrinks the error by the eccentricity (~1/30), so 3 steps take the ~2 days of the mean motion to ~1e-4 day.
+ *          The low accuracy longitude is offset to agree with `anchor_lon`, which cancels the slowly varying part of its error.
+ */
+inline auto estimate_root(const double anchor_jde, const double anchor_lon, const double travelled) -> double {
+  const double offset = anchor_lon - low_accuracy_longitude(anchor_jde);
+  const double expected_lon = anchor_lon + travelled;
 
-  return [=](const double jde) -> double {
-    return modified_solar_longitude(jde) - expected_lon;
-  };
-}
+  double jde = anchor_jde + travelled / MEAN_MOTION;
+  for (std::size_t i = 0; i < 3; ++i) {
+    jde += astro::toolbox::normalize_pm180(expected_lon - offset - low_accuracy_longitude(jde)) / MEAN_MOTION;
+  }
 
-/** 
- * @brief Apply Newton's method to find the root.
- * @param f The function to find the root.
- * @param start_jde The left bound of JDE's range, inclusive.
- * @param end_jde The right bound of JDE's range, exclusive.
- * @param episilon The tolerance. Default is 1e-10.
- * @param max_iter The maximum number of iterations. Default is 20.
- * @returns The approximated root (i.e. JDE). */
-inline auto newton_method(
-  const FuncType& f,              // The f function to find root(s) for.
-  const double start_jde,         // The left bound of JDE's range, inclusive.
-  const double end_jde,           // The right bound of JDE's range, exclusive.
-  const double episilon = 1e-15,  // The tolerance.
-  const std::size_t max_iter = 30 // The maximum number of iterations.
-) -> double {
-  // `pull_back` ensures the returned JDE is in valid range.
-  const auto pull_back = [&](const double jde) -> double {
-    if (jde < start_jde) {
-      return start_jde;
-    }
-    if (jde >= end_jde) {
-      return end_jde - 1e-20;
-    }
-    return jde;
-  };
+  return jde;
+}
 
-  // The step size. It is adaptive and gets smaller and smaller as it approaches the root.
-  double h = 5e-4;
 
-  // `next` returns (has_next, next_jde)
-  const auto next = [&](const double jde) -> std::pair<bool, double> {
-    const double f_jde = f(jde);
+/**
+ * @brief Estimate the root, i.e. the JDE in the year when the Sun reaches the expected longitude.
+ * @param bounds The bounds of the year.
+ * @param travelled The longitude travelled by the Sun since the start of the year, in degrees, in [0, 360 + `end_lon` - `start_lon`).
+ * @return The estimated root, clamped to the year. See `estimate_root` above.
+ *         Anchored on the low accuracy longitude at the start, so the seed is within ~0.02 day.
+ */
+inline auto estimate_root(const YearBounds& bounds, const double travelled) -> double {
+  return bounds.clamp(estimate_root(bounds.start_jde, bounds.start_lon, travelled));
+}
 
-    // Do the Newton's method.
-    const double f_prime_jde = (f(jde + h) - f(jde - h)) / (2.0 * h); // Approximate the derivative.
-    const double next_jde = jde - f_jde / f_prime_jde;                // Approximate our next guess.
 
-    if (std::fabs(next_jde - jde) < episilon) {
-      return { false, pull_back(next_jde) };
-    }
+/**
+ * @brief Refine the estimated root by Newton's method, with the closed-form rate of the Sun.
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param bounds The bounds of the year. The root must be in [start_jde, end_jde). Its ephemeris is looked up, if any.
+ * @param expected_lon The expected solar longitude, in degrees.
+ * @param estimate The estimated root, see `estimate_root`.
+ * @param max_iter The maximum number of iterations. Default is 8.
+ * @return The root, to ~1e-9 day (~0.1 ms).
+ * @throw std::runtime_error If the iteration does not converge within `max_iter` iterations.
+ * @details The error after a step is ~(f''/2f')·step², with f''/2f' < 3e-4 per day for the Sun, 
+ *          plus ~δ·step, where δ < 1e-6 is the relative error of the closed-form rate.
+ *          So after a step below 1e-4 day, the error is ~1e-10 day, and no evaluation is spent only to confirm it.
+ */
+template <Precision precision = Precision::FULL>
+inline auto refine_root(
+  const YearBounds& bounds, 
+  const double expected_lon, 
+  const double estimate, 
+  const std::size_t max_iter = 8
+) -> double {
+  namespace solve = astro::solve;
 
-    return { true, pull_back(next_jde) }; // Don't forget to pull the jde back to valid range.
+  // The ephemeris is the one snapshotted with the bounds, rather than looked up per evaluation.
+  const auto f = [expected_lon, ephemeris = bounds.ephemeris.get()](const double jde) -> solve::Sample {
+    const auto [lon, rate] = solar_longitude_with_rate<precision>(jde, ephemeris);
+    return { .value = astro::toolbox::normalize_pm180(lon - expected_lon), .derivative = rate };
   };
 
-  // Start approximating the root.
+  const solve::Options options { .tolerance = 1e-4 * solve::SECONDS_PER_DAY, .max_iterations = max_iter };
+  const solve::Interval interval { .lower = bounds.start_jde, .upper = std::nextafter(bounds.end_jde, bounds.start_jde) };
+  const auto result = solve::newton(f, estimate, options, interval);
+  if (!result.converged) [[unlikely]] {
+    throw std::runtime_error {
+      std::format("The solar longitude {} does not converge from the estimate {}.", expected_lon, estimate)
+    };
+  }
 
-  double jde = (start_jde + end_jde) / 2.0; // Initial guess.
+  return result.root;
+}
 
-  for (std::size_t iter_count = 0; iter_count < max_iter; iter_count++) {
-    // Do the Newton's method.
-    const auto& [has_next, next_jde] = next(jde);
-    jde = next_jde;
 
-    if (!has_next) {
-      break;
-    }
+/** 
+ * @brief Find the roots (i.e. JDEs) in a year whose bounds are evaluated already. 
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
+ * @param bounds The bounds of the year, see `year_bounds`.
+ * @param expected_lon The expected solar longitude, in degrees.
+ * @return The roots (i.e. JDEs), in ascending order. There can be 0, 1 or 2 roots.
+ */
+template <Precision precision = Precision::FULL>
+inline auto find_roots(const YearBounds& bounds, const double expected_lon) -> std::vector<double> {
+  std::vector<double> roots;
+
+  // The root before the spring equinox, where the longitude has not wrapped yet.
+  if (has_root_before_spring_equinox<precision>(bounds, expected_lon)) {
+    const double travelled = expected_lon - bounds.start_lon;
+    roots.emplace_back(refine_root<precision>(bounds, expected_lon, estimate_root(bounds, travelled)));
+  }
 
-    // Update the step size.
-    // Make the step size adaptive, for faster convergence.
-    if (h > 1e-10) {
-      h /= std::numbers::phi;
-    }
+  // The root after the spring equinox, where the longitude has wrapped.
+  if (has_root_after_spring_equinox<precision>(bounds, expected_lon)) {
+    const double travelled = expected_lon + 360.0 - bounds.start_lon;
+    roots.emplace_back(refine_root<precision>(bounds, expected_lon, estimate_root(bounds, travelled)));
   }
 
-  // We cannot find the accurate root in the above iterations.
-  // Return our best estimation.
-  return jde;
+  return roots;
 }
 
 
 /** 
  * @brief Find the roots (i.e. JDEs) for the given `year` and `expected_lon`. 
+ * @tparam precision The precision tier of VSOP87D, see `astro::vsop87d::Precision`.
  * @param year The year, in gregorian calendar.
  * @param expected_lon The expected solar longitude, in degrees.
  * @return The roots (i.e. JDEs). There can be 0, 1 or 2 roots.
  */
+template <Precision precision = Precision::FULL>
 inline auto find_roots(const int32_t year, const double expected_lon) -> std::vector<double> {
-  if (discriminant(year, expected_lon) == 0) { // No root.
-    return {};
-  }
-
-  std::vector<FuncType> f_vec;
-
-  // If there is a root before Spring Equinox, it means that
-  // after modification (for the sake of differentiability of f),
-  // the solar longitudes before spring equinox will be negative.
-  // And accordingly, we need to subtract 360.0 from the expected_lon.
-  if (has_root_before_spring_equinox(year, expected_lon)) {
-    f_vec.emplace_back(make_f(year, expected_lon - 360.0));
-  }
-
-  // If there is a root after Spring Equinox, it means that
-  // after modification (for the sake of differentiability of f),
-  // the solar longitudes after spring equinox will be positive.
-  // And accordingly, we have no need to modify the expected_lon.
-  if (has_root_after_spring_equinox(year, expected_lon)) {
-    f_vec.emplace_back(make_f(year, expected_lon));
-  }
-
-  // "nm" here denotes "newton_method".
-  auto apply_nm = [&](const FuncType& f) {
-    const double start_jde = get_start_jde(year);
-    const double end_jde   = get_end_jde(year);
-    return newton_method(f, start_jde, end_jde);
-  };
-
-  using namespace std::ranges;
-  return f_vec | views::transform(apply_nm) | to<std::vector>();
+  return find_roots<precision>(year_bounds(year), expected_lon);
 }
 
 // NOLINTEND(bugprone-easily-swappable-parameters)
@@ -280,6 +280,19 @@ struct SphericalCoordinate {
   Distance<DistanceUnit::AU> r; // Radius/Distance
 };
 
+/** @struct The time derivatives of a `SphericalCoordinate`. */
+struct SphericalRate {
+  double λ; // Degrees per day
+  double β; // Degrees per day
+  double r; // AU per day
+};
+
+/** @struct A spherical coordinate, together with its time derivatives. */
+struct SphericalCoordinateWithRate {
+  SphericalCoordinate coord;
+  SphericalRate       rate;
+};
+
 #pragma endregion
 
 } // namespace astro::toolbox
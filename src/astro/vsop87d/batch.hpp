@@ -0,0 +1,166 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <ranges>
+#include <algorithm>
+#include <stdexcept>
+
+#include "simd.hpp"
+#include "defines.hpp"
+
+namespace astro::vsop87d {
+
+#pragma region Batch Evaluation
+
+// `evaluate<planet>` walks all the coefficients once per epoch, and vectorizes across the terms.
+// For bulk jobs (e.g. ephemeris exports), the following functions do the opposite:
+// the loops are term-outer and time-inner, so every coefficient triple is loaded once per tile of epochs,
+// and the inner loop vectorizes across time.
+//
+// Per epoch, the terms are still accumulated in table order, so the results are the same as `evaluate<planet>`.
+
+/**
+ * @brief The number of epochs evaluated together.
+ * @note A tile keeps 3 arrays of `BATCH_TILE` doubles (the jms, one table's sums and the Horner accumulator),
+ *       i.e. 6KB, in L1, while the coefficient tables (~58KB for Earth) are streamed from L2 once per tile.
+ */
+constexpr std::size_t BATCH_TILE = 256;
+static_assert(BATCH_TILE % simd::LANES == 0);
+
+/** @brief A tile of per-epoch values, aligned for vector loads. */
+using Tile = std::array<double, BATCH_TILE>;
+
+
+/**
+ * @brief Evaluate a SoA VSOP87D table on a tile of julian millenniums.
+ * @param soa_table The VSOP87D table, in structure-of-arrays layout.
+ * @param jms The julian millenniums. Only the first `count` (rounded up to full vectors) are used.
+ * @param count The number of valid epochs in the tile.
+ * @param sums The output, the sums of the terms in the table for every epoch.
+ */
+inline void evaluate_table_tile(const SoaTable& soa_table, const Tile& jms, const std::size_t count, Tile& sums) {
+  // Each block of `BLOCK_VECTORS` vectors of epochs is kept in registers while all the terms stream through.
+  // The independent vectors also give the CPU several `simd::cos` dependency chains to overlap.
+  constexpr std::size_t BLOCK_VECTORS = 4;
+  constexpr std::size_t BLOCK = BLOCK_VECTORS * simd::LANES;
+  static_assert(BATCH_TILE % BLOCK == 0);
+
+  for (std::size_t begin = 0; begin < count; begin += BLOCK) {
+    std::array<simd::VecD, BLOCK_VECTORS> jm {};
+    std::array<simd::VecD, BLOCK_VECTORS> sum {};
+    for (std::size_t v = 0; v < BLOCK_VECTORS; ++v) {
+      jm[v] = simd::load(jms, begin + v * simd::LANES);
+    }
+
+    // Term-outer.
+    for (std::size_t i = 0; i < soa_table.A.size(); ++i) {
+      const double A = soa_table.A[i];
+      const double B = soa_table.B[i];
+      const double C = soa_table.C[i];
+
+      // Time-inner.
+      for (std::size_t v = 0; v < BLOCK_VECTORS; ++v) {
+        sum[v] += A * simd::cos(B + C * jm[v]);
+      }
+    }
+
+    for (std::size_t v = 0; v < BLOCK_VECTORS; ++v) {
+      simd::store(sums, begin + v * simd::LANES, sum[v] / SCALING_FACTOR);
+    }
+  }
+}
+
+
+/**
+ * @brief Evaluate SoA VSOP87D tables on a tile of julian millenniums.
+ * @param soa_tables The VSOP87D tables, in structure-of-arrays layout.
+ * @param jms The julian millenniums.
+ * @param count The number of valid epochs in the tile.
+ * @param results The output, the evaluated results (in radians, or AU for R tables) for every epoch.
+ */
+inline void evaluate_tables_tile(const SoaTables& soa_tables, const Tile& jms, const std::size_t count, Tile& results) {
+  alignas(simd::ALIGNMENT) Tile sums {};
+  results.fill(0.0);
+
+  // Same as `evaluate_tables`, the table results are accumulated in reverse order (Horner's method).
+  for (const SoaTable& soa_table : std::views::reverse(soa_tables)) {
+    evaluate_table_tile(soa_table, jms, count, sums);
+    for (std::size_t t = 0; t < count; ++t) {
+      results[t] = results[t] * jms[t] + sums[t];
+    }
+  }
+}
+
+
+/**
+ * @brief Evaluate the VSOP87D tables on many julian millenniums.
+ * @tparam planet The planet to evaluate.
+ * @tparam precision The precision tier, see `Precision`. Not `Precision::MIXED`, whose tail is in single precision.
+ * @param jms The julian millenniums since J2000, calculated based on JDE (julian ephemeris date).
+ * @param out The output, where `out[i]` is the evaluation at `jms[i]`. Must be of the same size as `jms`.
+ * @throw std::invalid_argument If the sizes of `jms` and `out` differ.
+ * @throw std::runtime_error If the tables of the planet are not loaded, see `require_tables`.
+ * @details Equivalent to `out[i] = evaluate<planet, precision>(jms[i])`, but much faster for large batches.
+ */
+template <Planet planet, Precision precision = Precision::FULL>
+inline void evaluate_batch(const std::span<const double> jms, const std::span<Evaluation> out) {
+  if (jms.size() != out.size()) {
+    throw std::invalid_argument { "The sizes of `jms` and `out` must be the same." };
+  }
+  static_assert(precision != Precision::MIXED, "The batches are evaluated in double precision only, see `Precision::MIXED`.");
+  require_tables<planet>();
+
+  using Tier = typename PlannetTables<planet>::template Tier<precision>;
+  const auto& L = Tier::L;
+  const auto& B = Tier::B;
+  const auto& R = Tier::R;
+
+  alignas(simd::ALIGNMENT) Tile jm_tile;
+  alignas(simd::ALIGNMENT) Tile λ_tile;
+  alignas(simd::ALIGNMENT) Tile β_tile;
+  alignas(simd::ALIGNMENT) Tile r_tile;
+
+  for (std::size_t begin = 0; begin < jms.size(); begin += BATCH_TILE) {
+    const std::size_t count = std::min(BATCH_TILE, jms.size() - begin);
+
+    // The tail of the last tile is padded with zeros, whose results are discarded.
+    jm_tile.fill(0.0);
+    std::ranges::copy(jms.subspan(begin, count), jm_tile.begin());
+
+    evaluate_tables_tile(L, jm_tile, count, λ_tile);
+    evaluate_tables_tile(B, jm_tile, count, β_tile);
+    evaluate_tables_tile(R, jm_tile, count, r_tile);
+
+    for (std::size_t t = 0; t < count; ++t) {
+      out[begin + t] = { .λ = λ_tile[t], .β = β_tile[t], .r = r_tile[t] };
+    }
+  }
+}
+
+#pragma endregion
+
+} // namespace astro::vsop87d
@@ -24,9 +24,17 @@
 #pragma once
 
 #include <span>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <limits>
 #include <ranges>
 #include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "simd.hpp"
 
 namespace astro::vsop87d {
 
@@ -43,10 +51,53 @@ using Vsop87dTable = std::span<const Coefficients>;
 /** @brief The VSOP87D tables. */
 using Vsop87dTables = std::span<const Vsop87dTable>;
 
-#pragma endregion
+/**
+ * @struct A VSOP87D table in structure-of-arrays layout, i.e. the As, Bs and Cs are stored separately.
+ * @note The number of terms is always a multiple of `simd::LANES`. Padding terms are all zeros, which evaluate to 0.
+ */
+struct SoaTable {
+  std::span<const double> A;
+  std::span<const double> B;
+  std::span<const double> C;
+};
 
+/** @brief The VSOP87D tables, in structure-of-arrays layout. */
+using SoaTables = std::span<const SoaTable>;
+
+/**
+ * @struct The storage backing a `SoaTable` converted from a table of `N` terms.
+ * @note The arrays are aligned and zero-padded, so that the kernels can always load full vectors.
+ */
+template <std::size_t N>
+struct SoaStorage {
+  static constexpr std::size_t SIZE = simd::padded(N);
+
+  alignas(simd::ALIGNMENT) std::array<double, SIZE> A {};
+  alignas(simd::ALIGNMENT) std::array<double, SIZE> B {};
+  alignas(simd::ALIGNMENT) std::array<double, SIZE> C {};
+
+  /** @brief Return the `SoaTable` view of this storage. */
+  [[nodiscard]] constexpr auto view() const -> SoaTable {
+    return { .A = A, .B = B, .C = C };
+  }
+};
+
+/**
+ * @brief Convert a VSOP87D table to structure-of-arrays layout, at compile time.
+ * @param table The VSOP87D table, in array-of-structs layout.
+ * @return The storage holding the table in structure-of-arrays layout.
+ */
+template <std::size_t N>
+constexpr auto to_soa(const std::array<Coefficients, N>& table) -> SoaStorage<N> {
+  SoaStorage<N> storage;
+  for (std::size_t i = 0; i < N; ++i) {
+    storage.A[i] = table[i].A;
+    storage.B[i] = table[i].B;
+    storage.C[i] = table[i].C;
+  }
+  return storage;
+}
 
-#pragma region VSOP87D Evaluation
 
 /**
  * @brief The scaling factor used for the VSOP87D tables in this project.
@@ -55,6 +106,211 @@ using Vsop87dTables = std::span<const Vsop87dTable>;
  */
 constexpr double SCALING_FACTOR = 1e8;
 
+#pragma endregion
+
+
+#pragma region Precision Tiers
+
+// Not every caller needs the full VSOP87D series. E.g. deciding the day a solar term falls on needs ~1″,
+// while deciding whether the Sun is above the horizon needs ~1′.
+// So the tables can be truncated at compile time, by dropping the terms whose |A|·T^k is below a threshold,
+// where k is the power of the table (e.g. 1 for L1), and T is `TRUNCATION_JM`.
+//
+// For every table, the threshold is the largest one such that the sum of the dropped |A|·T^k 
+// is no more than the table's share of the tolerance. So for |jm| <= T, the truncation error is bounded by the tolerance.
+
+/** 
+ * @enum The precision tiers of the VSOP87D evaluation.
+ * @note The tolerances are guaranteed for |jm| <= `TRUNCATION_JM`. The measured errors are for Earth, |jm| <= 2.
+ */
+enum class Precision : uint8_t { 
+  FULL,       // The full series.
+  MIXED,      // The full series, with the small terms in single precision, see `MIXED_THRESHOLD`. Earth: 213 + 2212 terms, measured λ 1.1e-10, β 1.1e-13, r 1.8e-12 AU over |jm| <= 4.
+  ARCSEC,     // λ and β within 1″, r within 4.8e-6 AU. Earth: 612 of the 2425 terms, measured λ 0.21″, β 0.14″, r 1.4e-6 AU.
+  TEN_ARCSEC, // λ and β within 10″, r within 4.8e-5 AU. Earth: 138 of the 2425 terms, measured λ 2.0″, β 1.2″, r 8.5e-6 AU.
+  ARCMIN,     // λ and β within 1′, r within 2.9e-4 AU. Earth: 36 of the 2425 terms, measured λ 15″, β 1.2″, r 4.9e-5 AU.
+};
+
+/** @brief The |jm| up to which the tolerances of the precision tiers are guaranteed, i.e. the years 0 to 4000. */
+constexpr double TRUNCATION_JM = 2.0;
+
+/** @brief The tolerance of `Precision::MIXED`, which is the rounding of the single-precision terms, not a truncation. */
+constexpr double MIXED_TOLERANCE = 1e-10;
+
+/** 
+ * @brief Return the tolerance of the given precision tier.
+ * @return The tolerance, in radians for λ and β, and in AU for r (the same value). 0 for `Precision::FULL`.
+ */
+constexpr auto tolerance(const Precision precision) -> double {
+  constexpr double ARCSEC_IN_RAD = std::numbers::pi / 180.0 / 3600.0;
+  switch (precision) {
+    case Precision::FULL:       return 0.0;
+    case Precision::MIXED:      return MIXED_TOLERANCE;
+    case Precision::ARCSEC:     return ARCSEC_IN_RAD;
+    case Precision::TEN_ARCSEC: return ARCSEC_IN_RAD * 10.0;
+    case Precision::ARCMIN:     return ARCSEC_IN_RAD * 60.0;
+  }
+  return 0.0;
+}
+
+
+/**
+ * @brief Return the weight of a term in a truncation, i.e. |A|·T^power, where T is `TRUNCATION_JM`.
+ * @param term The term.
+ * @param power The power of the table, e.g. 1 for L1.
+ */
+constexpr auto truncation_weight(const Coefficients& term, const std::size_t power) -> double {
+  double weight = term.A < 0.0 ? -term.A : term.A;
+  for (std::size_t i = 0; i < power; ++i) {
+    weight *= TRUNCATION_JM;
+  }
+  return weight;
+}
+
+/**
+ * @brief Return the threshold of the truncation of the given table. The terms with smaller weights are dropped.
+ * @param table The VSOP87D table.
+ * @param power The power of the table, e.g. 1 for L1.
+ * @param budget The maximum truncation error of the table, in radians (or AU).
+ * @return The threshold, in the same unit as the coefficient "A"s.
+ */
+template <std::size_t N>
+constexpr auto truncation_threshold(const std::array<Coefficients, N>& table, const std::size_t power, const double budget) -> double {
+  std::array<double, N> weights {};
+  for (std::size_t i = 0; i < N; ++i) {
+    weights[i] = truncation_weight(table[i], power);
+  }
+  std::ranges::sort(weights);
+
+  // Drop the lightest terms, as long as the dropped weights fit in the budget.
+  double dropped = 0.0;
+  for (const double weight : weights) {
+    if (dropped + weight > budget * SCALING_FACTOR) {
+      return weight;
+    }
+    dropped += weight;
+  }
+
+  // All the terms can be dropped.
+  return std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Truncate a VSOP87D table and convert it to structure-of-arrays layout, at compile time.
+ * @tparam precision The precision tier.
+ * @tparam power The power of the table, e.g. 1 for L1.
+ * @tparam count The number of tables in the series (e.g. 6 for L), which share the tolerance equally.
+ * @tparam table The VSOP87D table, in array-of-structs layout.
+ * @return The storage holding the kept terms in structure-of-arrays layout, in the same order as `table`.
+ */
+template <Precision precision, std::size_t power, std::size_t count, const auto& table>
+constexpr auto truncate() {
+  constexpr double budget = tolerance(precision) / static_cast<double>(count);
+  constexpr double threshold = truncation_threshold(table, power, budget);
+  constexpr std::size_t kept = std::ranges::count_if(table, [](const Coefficients& term) {
+    return truncation_weight(term, power) >= threshold;
+  });
+
+  SoaStorage<kept> storage;
+  std::size_t i = 0;
+  for (const Coefficients& term : table) {
+    if (truncation_weight(term, power) >= threshold) {
+      storage.A[i] = term.A;
+      storage.B[i] = term.B;
+      storage.C[i] = term.C;
+      ++i;
+    }
+  }
+  return storage;
+}
+
+#pragma endregion
+
+
+#pragma region Mixed Precision
+
+// Most terms are tiny: only 213 of the Earth's 2425 terms have |A| of 1e-7 or more. 
+// Their cosines do not need double precision, since a relative error of ~1e-7 in a term of 1e-7 is ~1e-14.
+//
+// With `Precision::MIXED`, every table is split at `MIXED_THRESHOLD` at compile time.
+// The head (the large terms) is evaluated in double precision, exactly like `evaluate_table`.
+// The tail is evaluated with `simd::cos_narrow`, whose polynomial runs in single precision on twice as many lanes,
+// and is accumulated in single-precision lanes with Kahan's compensation, before it is folded into the head in double precision.
+
+/** @brief The terms whose |A|·T^k (see `truncation_weight`) is below this threshold are evaluated in single precision. */
+constexpr double MIXED_THRESHOLD = 1e-7;
+
+/** @struct The tail of a mixed-precision table: the "A"s are floats, while the "B"s and "C"s stay doubles for the range reduction. */
+struct TailTable {
+  std::span<const float>  A;
+  std::span<const double> B;
+  std::span<const double> C;
+};
+
+/** @struct A VSOP87D table split for the mixed-precision evaluation. */
+struct MixedTable {
+  SoaTable  head; // The terms evaluated in double precision.
+  TailTable tail; // The terms evaluated in single precision.
+};
+
+/** @brief The VSOP87D tables, split for the mixed-precision evaluation. */
+using MixedTables = std::span<const MixedTable>;
+
+/**
+ * @struct The storage backing a `MixedTable`, with `HEAD` terms in double precision and `TAIL` terms in single precision.
+ * @note The tail is zero-padded to a multiple of `simd::FLOAT_LANES`.
+ */
+template <std::size_t HEAD, std::size_t TAIL>
+struct MixedStorage {
+  static constexpr std::size_t TAIL_SIZE = simd::padded_float(TAIL);
+
+  SoaStorage<HEAD> head;
+  alignas(simd::ALIGNMENT) std::array<float,  TAIL_SIZE> A {};
+  alignas(simd::ALIGNMENT) std::array<double, TAIL_SIZE> B {};
+  alignas(simd::ALIGNMENT) std::array<double, TAIL_SIZE> C {};
+
+  /** @brief Return the `MixedTable` view of this storage. */
+  [[nodiscard]] constexpr auto view() const -> MixedTable {
+    return { .head = head.view(), .tail = { .A = A, .B = B, .C = C } };
+  }
+};
+
+/**
+ * @brief Split a VSOP87D table at `MIXED_THRESHOLD`, at compile time.
+ * @tparam power The power of the table, e.g. 1 for L1.
+ * @tparam table The VSOP87D table, in array-of-structs layout.
+ * @return The storage holding the head and the tail, each in the same order as `table`.
+ */
+template <std::size_t power, const auto& table>
+constexpr auto split() {
+  constexpr auto is_head = [](const Coefficients& term) {
+    return truncation_weight(term, power) >= MIXED_THRESHOLD * SCALING_FACTOR;
+  };
+  constexpr std::size_t head_count = std::ranges::count_if(table, is_head);
+
+  MixedStorage<head_count, table.size() - head_count> storage;
+  std::size_t head = 0;
+  std::size_t tail = 0;
+  for (const Coefficients& term : table) {
+    if (is_head(term)) {
+      storage.head.A[head] = term.A;
+      storage.head.B[head] = term.B;
+      storage.head.C[head] = term.C;
+      ++head;
+    } else {
+      storage.A[tail] = static_cast<float>(term.A);
+      storage.B[tail] = term.B;
+      storage.C[tail] = term.C;
+      ++tail;
+    }
+  }
+  return storage;
+}
+
+#pragma endregion
+
+
+#pragma region VSOP87D Evaluation
 
 /** 
  * @brief Return the sum of all the terms in the given VSOP87D table, for the given julian millennium. 
@@ -75,6 +331,32 @@ inline auto evaluate_table(const Vsop87dTable& vsop_table, const double jm) -> d
 }
 
 
+/** 
+ * @brief Return the sum of all the terms in the given SoA VSOP87D table, for the given julian millennium. 
+ * @param soa_table The VSOP87D table, in structure-of-arrays layout.
+ * @param jm The julian millennium.
+ * @return The sum of the terms in the table.
+ * @details The terms are evaluated `simd::LANES` at a time, with `simd::cos`.
+ *          Each term agrees with the array-of-structs `evaluate_table` up to `simd::TRIG_ULP_BOUND` ULPs of its amplitude,
+ *          and the summation order is the same, so the results match to within a few ULPs of the sum.
+ */
+inline auto evaluate_table(const SoaTable& soa_table, const double jm) -> double {
+  const simd::VecD vjm = simd::splat(jm);
+
+  double sum = 0.0;
+  for (std::size_t i = 0; i < soa_table.A.size(); i += simd::LANES) {
+    const simd::VecD x = simd::load(soa_table.B, i) + simd::load(soa_table.C, i) * vjm;
+    const simd::VecD terms = simd::load(soa_table.A, i) * simd::cos(x);
+
+    // The terms are accumulated in table order, exactly like the array-of-structs `evaluate_table`,
+    // since the leading terms dominate the sum and any reordering would change the rounding of the result.
+    sum = simd::accumulate(terms, sum);
+  }
+
+  return sum / SCALING_FACTOR;
+}
+
+
 /**
  * @brief Evaluate the given VSOP87D tables on the given julian millennium.
  * @param vsop_tables The VSOP87D tables.
@@ -100,13 +382,97 @@ inline auto evaluate_tables(const Vsop87dTables& vsop_tables, const double jm) -
   return accumulated;
 }
 
-/** @enum The planets supported by VSOP87D. */
-enum class Planet : uint8_t { EAR, /* SAT, MAR, ... */ };
 
-/** @struct The type trait for the VSOP87D tables. Expected specializations in `*_coeff.hpp`s. */
+/**
+ * @brief Evaluate the given SoA VSOP87D tables on the given julian millennium.
+ * @param soa_tables The VSOP87D tables, in structure-of-arrays layout.
+ * @param jm The julian millennium.
+ * @return The evaluated result. As per the VSOP87D model, the result is in radians.
+ */
+inline auto evaluate_tables(const SoaTables& soa_tables, const double jm) -> double {
+  // Same as above, the table results are accumulated in reverse order (Horner's method).
+  double accumulated = 0.0;
+  for (const SoaTable& soa_table : std::views::reverse(soa_tables)) {
+    accumulated = accumulated * jm + evaluate_table(soa_table, jm);
+  }
+  return accumulated;
+}
+
+/**
+ * @brief Return the sum of all the terms in the given mixed-precision table, for the given julian millennium.
+ * @param mixed_table The VSOP87D table, split by `split`.
+ * @param jm The julian millennium.
+ * @return The sum of the terms in the table, within `MIXED_TOLERANCE` of `evaluate_table` on the whole table.
+ */
+inline auto evaluate_table(const MixedTable& mixed_table, const double jm) -> double {
+  const auto& [A, B, C] = mixed_table.tail;
+  const simd::VecD vjm = simd::splat(jm);
+
+  simd::VecF sum {};
+  simd::VecF compensation {};
+  for (std::size_t i = 0; i < A.size(); i += simd::FLOAT_LANES) {
+    const simd::VecD x_lo = simd::load(B, i) + simd::load(C, i) * vjm;
+    const simd::VecD x_hi = simd::load(B, i + simd::LANES) + simd::load(C, i + simd::LANES) * vjm;
+    const simd::VecF terms = simd::load(A, i) * simd::cos_narrow(x_lo, x_hi);
+
+    // Kahan's summation, lane by lane.
+    const simd::VecF y = terms - compensation;
+    const simd::VecF t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+  }
+
+  // Fold the lanes and their compensations in double precision, where they are exact.
+  const double tail = simd::accumulate(sum, 0.0) - simd::accumulate(compensation, 0.0);
+  return evaluate_table(mixed_table.head, jm) + tail / SCALING_FACTOR;
+}
+
+
+/**
+ * @brief Evaluate the given mixed-precision VSOP87D tables on the given julian millennium.
+ * @param mixed_tables The VSOP87D tables, split by `split`.
+ * @param jm The julian millennium.
+ * @return The evaluated result, in radians (or AU).
+ */
+inline auto evaluate_tables(const MixedTables& mixed_tables, const double jm) -> double {
+  // Horner's method, like the SoA `evaluate_tables`.
+  double accumulated = 0.0;
+  for (const MixedTable& mixed_table : std::views::reverse(mixed_tables)) {
+    accumulated = accumulated * jm + evaluate_table(mixed_table, jm);
+  }
+  return accumulated;
+}
+
+/** 
+ * @enum The planets supported by VSOP87D. 
+ * @note The tables of `EAR` are built in, see `earth_coeff.hpp`. The tables of the other planets are loaded at runtime,
+ *       from the VSOP87D distribution files, see `loader.hpp`.
+ */
+enum class Planet : uint8_t { EAR, MER, VEN, MAR, JUP, SAT, URA, NEP };
+
+/** 
+ * @struct The type trait for the VSOP87D tables. Expected specializations in `*_coeff.hpp`s and `loader.hpp`. 
+ * @note A specialization provides `Tier<precision>`, whose `L`, `B`, `R` are the SoA tables truncated to the given precision tier.
+ *       The built-in specializations also provide `L`, `B`, `R` (array-of-structs) and `L_soa`, `B_soa`, `R_soa` (structure-of-arrays).
+ *       The specializations of the planets loaded at runtime provide `loaded()` instead, see `require_tables`.
+ */
 template <Planet planet>
 struct PlannetTables;
 
+/**
+ * @brief Make sure the tables of the given planet are available.
+ * @throw std::runtime_error If the tables of the planet are loaded at runtime, but not loaded yet.
+ * @note No-op for the built-in tables.
+ */
+template <Planet planet>
+inline void require_tables() {
+  if constexpr (requires { PlannetTables<planet>::loaded(); }) {
+    if (not PlannetTables<planet>::loaded()) {
+      throw std::runtime_error { "The VSOP87D tables of the planet are not loaded, see `astro::vsop87d::load`." };
+    }
+  }
+}
+
 /**
  * @struct The result of the VSOP87D evaluation.
  * @note This struct is expected to only hold the untouched results from the VSOP87D model.
@@ -120,20 +486,191 @@ struct Evaluation {
 /**
  * @brief Evaluate the VSOP87D tables on the given julian millennium.
  * @tparam planet The planet to evaluate.
+ * @tparam precision The precision tier. The cheaper tiers evaluate fewer terms, see `Precision`.
  * @param jm The julian millennium since J2000, calculated based on JDE (julian ephemeris date).
  * @return The evaluation result. VSOP87D provides the heliocentric ecliptic spherical coordinates for the equinox of the day.
+ * @throw std::runtime_error If the tables of the planet are not loaded, see `require_tables`.
  * @example `evaluate<Planet::EAR>(0.0)` means evaluating the Earth's L, B, and R tables on the given julian millennium 0.0.
  */
-template <Planet planet>
+template <Planet planet, Precision precision = Precision::FULL>
 inline auto evaluate(const double jm) -> Evaluation {
-  const auto& L = PlannetTables<planet>::L;
-  const auto& B = PlannetTables<planet>::B;
-  const auto& R = PlannetTables<planet>::R;
+  require_tables<planet>();
+
+  // Use the SoA layout, which is evaluated with SIMD.
+  using Tier = typename PlannetTables<planet>::template Tier<precision>;
+  if constexpr (precision == Precision::MIXED) {
+    // The small terms are evaluated in single precision.
+    return {
+      .λ = evaluate_tables(Tier::L_mixed, jm), 
+      .β = evaluate_tables(Tier::B_mixed, jm), 
+      .r = evaluate_tables(Tier::R_mixed, jm),
+    };
+  } else {
+    const auto& L = Tier::L;
+    const auto& B = Tier::B;
+    const auto& R = Tier::R;
+
+    return {
+      .λ = evaluate_tables(L, jm), 
+      .β = evaluate_tables(B, jm), 
+      .r = evaluate_tables(R, jm),
+    };
+  }
+}
+
+
+/**
+ * @struct The result of the VSOP87D evaluation, with the time derivatives.
+ * @note The rates are per julian millennium, i.e. radians/millennium for λ and β, and AU/millennium for r.
+ */
+struct EvaluationWithRate {
+  Evaluation value;
+  Evaluation rate;
+};
+
+/** @struct The sum of the terms in a table, and its time derivative. */
+struct TableSumWithRate {
+  double value;
+  double rate;
+};
+
+
+/**
+ * @brief Return the sum of all the terms in the given SoA VSOP87D table, and its derivative with respect to `jm`.
+ * @param soa_table The VSOP87D table, in structure-of-arrays layout.
+ * @param jm The julian millennium.
+ * @return The sum of A·cos(B + C·jm), which is the same as `evaluate_table`, and the sum of -A·C·sin(B + C·jm).
+ * @details The sines share the range reduction with the cosines, via `simd::sincos`.
+ */
+inline auto evaluate_table_with_rate(const SoaTable& soa_table, const double jm) -> TableSumWithRate {
+  const simd::VecD vjm = simd::splat(jm);
+
+  double sum = 0.0;
+  double rate = 0.0;
+  for (std::size_t i = 0; i < soa_table.A.size(); i += simd::LANES) {
+    const simd::VecD A = simd::load(soa_table.A, i);
+    const simd::VecD C = simd::load(soa_table.C, i);
+    const auto [sin, cos] = simd::sincos(simd::load(soa_table.B, i) + C * vjm);
+
+    // Same order as `evaluate_table`, so the sums are identical.
+    sum = simd::accumulate(A * cos, sum);
+    rate = simd::accumulate(-A * C * sin, rate);
+  }
+
+  return { .value = sum / SCALING_FACTOR, .rate = rate / SCALING_FACTOR };
+}
+
+
+/**
+ * @brief Return the sum of all the terms in the given mixed-precision table, and its derivative with respect to `jm`.
+ * @param mixed_table The VSOP87D table, split by `split`.
+ * @param jm The julian millennium.
+ * @return The same sum as the mixed-precision `evaluate_table`, and the sum of -A·C·sin(B + C·jm).
+ * @details The head is differentiated in double precision. The tail's rate is in single precision like its sum,
+ *          with sin(x) evaluated as cos(x - π/2) by `simd::cos_narrow`.
+ */
+inline auto evaluate_table_with_rate(const MixedTable& mixed_table, const double jm) -> TableSumWithRate {
+  const auto [head_value, head_rate] = evaluate_table_with_rate(mixed_table.head, jm);
+
+  const auto& [A, B, C] = mixed_table.tail;
+  const simd::VecD vjm = simd::splat(jm);
+  const simd::VecD half_π = simd::splat(std::numbers::pi / 2.0);
+
+  simd::VecF sum {};
+  simd::VecF compensation {};
+  simd::VecF rate {};
+  for (std::size_t i = 0; i < A.size(); i += simd::FLOAT_LANES) {
+    const simd::VecD C_lo = simd::load(C, i);
+    const simd::VecD C_hi = simd::load(C, i + simd::LANES);
+    const simd::VecD x_lo = simd::load(B, i) + C_lo * vjm;
+    const simd::VecD x_hi = simd::load(B, i + simd::LANES) + C_hi * vjm;
+    const simd::VecF a = simd::load(A, i);
+
+    // Same as the mixed-precision `evaluate_table`, so the sums are identical.
+    const simd::VecF terms = a * simd::cos_narrow(x_lo, x_hi);
+    const simd::VecF y = terms - compensation;
+    const simd::VecF t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+
+    rate -= a * simd::narrow(C_lo, C_hi) * simd::cos_narrow(x_lo - half_π, x_hi - half_π);
+  }
+
+  const double tail = simd::accumulate(sum, 0.0) - simd::accumulate(compensation, 0.0);
+  return { .value = head_value + tail / SCALING_FACTOR, .rate = head_rate + simd::accumulate(rate, 0.0) / SCALING_FACTOR };
+}
+
+
+/**
+ * @brief Evaluate the given SoA VSOP87D tables on the given julian millennium, with the derivative with respect to `jm`.
+ * @param soa_tables The VSOP87D tables, in structure-of-arrays layout.
+ * @param jm The julian millennium.
+ * @return The evaluated result, which is the same as `evaluate_tables`, and its derivative.
+ */
+inline auto evaluate_tables_with_rate(const SoaTables& soa_tables, const double jm) -> TableSumWithRate {
+  // Horner's method, differentiated: if p' = p·jm + S, then dp'/djm = dp/djm·jm + p + dS/djm.
+  double accumulated = 0.0;
+  double rate = 0.0;
+  for (const SoaTable& soa_table : std::views::reverse(soa_tables)) {
+    const auto [table_value, table_rate] = evaluate_table_with_rate(soa_table, jm);
+    rate = rate * jm + accumulated + table_rate;
+    accumulated = accumulated * jm + table_value;
+  }
+  return { .value = accumulated, .rate = rate };
+}
+
+
+/**
+ * @brief Evaluate the given mixed-precision VSOP87D tables on the given julian millennium, with the derivative with respect to `jm`.
+ * @param mixed_tables The VSOP87D tables, split by `split`.
+ * @param jm The julian millennium.
+ * @return The evaluated result, which is the same as the mixed-precision `evaluate_tables`, and its derivative.
+ */
+inline auto evaluate_tables_with_rate(const MixedTables& mixed_tables, const double jm) -> TableSumWithRate {
+  // Same as the SoA `evaluate_tables_with_rate`.
+  double accumulated = 0.0;
+  double rate = 0.0;
+  for (const MixedTable& mixed_table : std::views::reverse(mixed_tables)) {
+    const auto [table_value, table_rate] = evaluate_table_with_rate(mixed_table, jm);
+    rate = rate * jm + accumulated + table_rate;
+    accumulated = accumulated * jm + table_value;
+  }
+  return { .value = accumulated, .rate = rate };
+}
+
+
+/**
+ * @brief Evaluate the VSOP87D tables on the given julian millennium, with the time derivatives, in one pass.
+ * @tparam planet The planet to evaluate.
+ * @tparam precision The precision tier, see `Precision`.
+ * @param jm The julian millennium since J2000, calculated based on JDE (julian ephemeris date).
+ * @return The evaluation result, which is the same as `evaluate<planet, precision>`, and the rates per julian millennium.
+ */
+template <Planet planet, Precision precision = Precision::FULL>
+inline auto evaluate_with_rate(const double jm) -> EvaluationWithRate {
+  require_tables<planet>();
+
+  using Tier = typename PlannetTables<planet>::template Tier<precision>;
+  const auto [λ, β, r] = [jm] {
+    if constexpr (precision == Precision::MIXED) {
+      // The small terms are evaluated in single precision, like `evaluate`.
+      return std::array { 
+        evaluate_tables_with_rate(Tier::L_mixed, jm), 
+        evaluate_tables_with_rate(Tier::B_mixed, jm), 
+        evaluate_tables_with_rate(Tier::R_mixed, jm),
+      };
+    } else {
+      return std::array { 
+        evaluate_tables_with_rate(Tier::L, jm), 
+        evaluate_tables_with_rate(Tier::B, jm), 
+        evaluate_tables_with_rate(Tier::R, jm),
+      };
+    }
+  }();
 
   return {
-    .λ = evaluate_tables(L, jm), 
-    .β = evaluate_tables(B, jm), 
-    .r = evaluate_tables(R, jm),
+    .value = { .λ = λ.value, .β = β.value, .r = r.value },
+    .rate  = { .λ = λ.rate,  .β = β.rate,  .r = r.rate  },
   };
 }
 
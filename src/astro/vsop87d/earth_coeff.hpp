@@ -31,6 +31,11 @@ namespace astro::vsop87d::earth_coeff {
 using Coefficients  = astro::vsop87d::Coefficients;
 using Vsop87dTable  = astro::vsop87d::Vsop87dTable;
 using Vsop87dTables = astro::vsop87d::Vsop87dTables;
+using SoaTable      = astro::vsop87d::SoaTable;
+using SoaTables     = astro::vsop87d::SoaTables;
+using Precision     = astro::vsop87d::Precision;
+using MixedTable    = astro::vsop87d::MixedTable;
+using MixedTables   = astro::vsop87d::MixedTables;
 
 
 #pragma region L0-L5
@@ -2538,6 +2543,140 @@ constexpr std::array<Vsop87dTable, 6> R_array { R0, R1, R2, R3, R4, R5, };
 constexpr Vsop87dTables R { R_array };
 
 
+#pragma endregion
+
+
+#pragma region SoA Layout
+
+// The same tables as above, converted to structure-of-arrays layout at compile time, for SIMD evaluation.
+
+constexpr auto L0_soa = to_soa(L0);
+constexpr auto L1_soa = to_soa(L1);
+constexpr auto L2_soa = to_soa(L2);
+constexpr auto L3_soa = to_soa(L3);
+constexpr auto L4_soa = to_soa(L4);
+constexpr auto L5_soa = to_soa(L5);
+
+/** @brief The SoA L tables. */
+constexpr std::array<SoaTable, 6> L_soa_array { 
+  L0_soa.view(), L1_soa.view(), L2_soa.view(), L3_soa.view(), L4_soa.view(), L5_soa.view(), 
+};
+
+constexpr SoaTables L_soa { L_soa_array };
+
+
+constexpr auto B0_soa = to_soa(B0);
+constexpr auto B1_soa = to_soa(B1);
+constexpr auto B2_soa = to_soa(B2);
+constexpr auto B3_soa = to_soa(B3);
+constexpr auto B4_soa = to_soa(B4);
+
+/** @brief The SoA B tables. */
+constexpr std::array<SoaTable, 5> B_soa_array { 
+  B0_soa.view(), B1_soa.view(), B2_soa.view(), B3_soa.view(), B4_soa.view(), 
+};
+
+constexpr SoaTables B_soa { B_soa_array };
+
+
+constexpr auto R0_soa = to_soa(R0);
+constexpr auto R1_soa = to_soa(R1);
+constexpr auto R2_soa = to_soa(R2);
+constexpr auto R3_soa = to_soa(R3);
+constexpr auto R4_soa = to_soa(R4);
+constexpr auto R5_soa = to_soa(R5);
+
+/** @brief The SoA R tables. */
+constexpr std::array<SoaTable, 6> R_soa_array { 
+  R0_soa.view(), R1_soa.view(), R2_soa.view(), R3_soa.view(), R4_soa.view(), R5_soa.view(), 
+};
+
+constexpr SoaTables R_soa { R_soa_array };
+
+#pragma endregion
+
+
+#pragma region Precision Tiers
+
+// The SoA tables truncated to the precision tiers at compile time, see `vsop87d::Precision`.
+
+/** @struct The SoA tables truncated to the given precision tier. */
+template <Precision precision>
+struct Tier {
+  static constexpr auto L0_soa = truncate<precision, 0, 6, earth_coeff::L0>();
+  static constexpr auto L1_soa = truncate<precision, 1, 6, earth_coeff::L1>();
+  static constexpr auto L2_soa = truncate<precision, 2, 6, earth_coeff::L2>();
+  static constexpr auto L3_soa = truncate<precision, 3, 6, earth_coeff::L3>();
+  static constexpr auto L4_soa = truncate<precision, 4, 6, earth_coeff::L4>();
+  static constexpr auto L5_soa = truncate<precision, 5, 6, earth_coeff::L5>();
+
+  static constexpr std::array<SoaTable, 6> L_array { L0_soa.view(), L1_soa.view(), L2_soa.view(), L3_soa.view(), L4_soa.view(), L5_soa.view(), };
+  static constexpr SoaTables L { L_array };
+
+  static constexpr auto B0_soa = truncate<precision, 0, 5, earth_coeff::B0>();
+  static constexpr auto B1_soa = truncate<precision, 1, 5, earth_coeff::B1>();
+  static constexpr auto B2_soa = truncate<precision, 2, 5, earth_coeff::B2>();
+  static constexpr auto B3_soa = truncate<precision, 3, 5, earth_coeff::B3>();
+  static constexpr auto B4_soa = truncate<precision, 4, 5, earth_coeff::B4>();
+
+  static constexpr std::array<SoaTable, 5> B_array { B0_soa.view(), B1_soa.view(), B2_soa.view(), B3_soa.view(), B4_soa.view(), };
+  static constexpr SoaTables B { B_array };
+
+  static constexpr auto R0_soa = truncate<precision, 0, 6, earth_coeff::R0>();
+  static constexpr auto R1_soa = truncate<precision, 1, 6, earth_coeff::R1>();
+  static constexpr auto R2_soa = truncate<precision, 2, 6, earth_coeff::R2>();
+  static constexpr auto R3_soa = truncate<precision, 3, 6, earth_coeff::R3>();
+  static constexpr auto R4_soa = truncate<precision, 4, 6, earth_coeff::R4>();
+  static constexpr auto R5_soa = truncate<precision, 5, 6, earth_coeff::R5>();
+
+  static constexpr std::array<SoaTable, 6> R_array { R0_soa.view(), R1_soa.view(), R2_soa.view(), R3_soa.view(), R4_soa.view(), R5_soa.view(), };
+  static constexpr SoaTables R { R_array };
+};
+
+/** @struct The full SoA tables. */
+template <>
+struct Tier<Precision::FULL> {
+  static constexpr const SoaTables& L = L_soa;
+  static constexpr const SoaTables& B = B_soa;
+  static constexpr const SoaTables& R = R_soa;
+};
+
+/** 
+ * @struct The full tables, split for the mixed-precision evaluation. 
+ * @note There are no `L`, `B` and `R`, so the evaluators that only run in double precision (e.g. `evaluate_batch`) reject this tier.
+ */
+template <>
+struct Tier<Precision::MIXED> {
+  static constexpr auto L0_mixed = split<0, earth_coeff::L0>();
+  static constexpr auto L1_mixed = split<1, earth_coeff::L1>();
+  static constexpr auto L2_mixed = split<2, earth_coeff::L2>();
+  static constexpr auto L3_mixed = split<3, earth_coeff::L3>();
+  static constexpr auto L4_mixed = split<4, earth_coeff::L4>();
+  static constexpr auto L5_mixed = split<5, earth_coeff::L5>();
+
+  static constexpr std::array<MixedTable, 6> L_mixed_array { L0_mixed.view(), L1_mixed.view(), L2_mixed.view(), L3_mixed.view(), L4_mixed.view(), L5_mixed.view(), };
+  static constexpr MixedTables L_mixed { L_mixed_array };
+
+  static constexpr auto B0_mixed = split<0, earth_coeff::B0>();
+  static constexpr auto B1_mixed = split<1, earth_coeff::B1>();
+  static constexpr auto B2_mixed = split<2, earth_coeff::B2>();
+  static constexpr auto B3_mixed = split<3, earth_coeff::B3>();
+  static constexpr auto B4_mixed = split<4, earth_coeff::B4>();
+
+  static constexpr std::array<MixedTable, 5> B_mixed_array { B0_mixed.view(), B1_mixed.view(), B2_mixed.view(), B3_mixed.view(), B4_mixed.view(), };
+  static constexpr MixedTables B_mixed { B_mixed_array };
+
+  static constexpr auto R0_mixed = split<0, earth_coeff::R0>();
+  static constexpr auto R1_mixed = split<1, earth_coeff::R1>();
+  static constexpr auto R2_mixed = split<2, earth_coeff::R2>();
+  static constexpr auto R3_mixed = split<3, earth_coeff::R3>();
+  static constexpr auto R4_mixed = split<4, earth_coeff::R4>();
+  static constexpr auto R5_mixed = split<5, earth_coeff::R5>();
+
+  static constexpr std::array<MixedTable, 6> R_mixed_array { R0_mixed.view(), R1_mixed.view(), R2_mixed.view(), R3_mixed.view(), R4_mixed.view(), R5_mixed.view(), };
+  static constexpr MixedTables R_mixed { R_mixed_array };
+};
+
 #pragma endregion
 
 } // namespace astro::vsop87d::earth_coeff
@@ -2551,6 +2690,13 @@ struct PlannetTables<Planet::EAR> {
   static const inline Vsop87dTables& L = vsop87d::earth_coeff::L;
   static const inline Vsop87dTables& B = vsop87d::earth_coeff::B;
   static const inline Vsop87dTables& R = vsop87d::earth_coeff::R;
+
+  static const inline SoaTables& L_soa = vsop87d::earth_coeff::L_soa;
+  static const inline SoaTables& B_soa = vsop87d::earth_coeff::B_soa;
+  static const inline SoaTables& R_soa = vsop87d::earth_coeff::R_soa;
+
+  template <Precision precision>
+  using Tier = vsop87d::earth_coeff::Tier<precision>;
 };
 
 } // namespace astro::vsop87d
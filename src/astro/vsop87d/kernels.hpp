@@ -0,0 +1,140 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "simd.hpp"
+#include "defines.hpp"
+
+// The VSOP87D kernels specialized per planet and precision tier, generated at build time.
+// `tools/gen_vsop87d_kernels.cpp` writes one translation unit per planet and tier, which holds the tables as
+// fixed-size aligned blocks, and unrolls the polynomial in jm. The generated sources are built into the
+// `vsop87d_kernels` library; this header only declares them, so it is usable only when linking that library.
+//
+// The generated tables are prepared ahead of time:
+// - The "A"s are already divided by `SCALING_FACTOR`.
+// - The terms with C = 0 (e.g. the mean motion in L1) are folded into a constant, which is added after the periodic terms.
+// - The terms are zero-padded to full blocks of `BLOCK`, i.e. one cache line, whatever the SIMD width is.
+//
+// Unlike `evaluate_table`, the periodic terms are accumulated lane-wise, and before the constant.
+// So the results differ from `vsop87d::evaluate` by rounding only: up to ~3e-11 radians for λ (mostly the rounding
+// of the table-order sums in L1, which add every term to the large constant), and ~1e-14 for β and r, for |jm| <= 1.
+
+namespace astro::vsop87d::kernels {
+
+#pragma region Kernel
+
+/** @brief The generated tables are padded to multiples of `BLOCK` terms, i.e. one cache line. */
+constexpr std::size_t BLOCK = 8;
+
+static_assert(BLOCK % simd::LANES == 0);
+static_assert(BLOCK * sizeof(double) == simd::ALIGNMENT);
+
+
+/**
+ * @struct The terms of a generated VSOP87D table, in structure-of-arrays layout.
+ * @tparam N The number of terms, padded to a multiple of `BLOCK`.
+ */
+template <std::size_t N>
+struct Terms {
+  static_assert(N % BLOCK == 0, "The generated tables are padded to full blocks.");
+
+  alignas(simd::ALIGNMENT) std::array<double, N> A; // Divided by `SCALING_FACTOR`.
+  alignas(simd::ALIGNMENT) std::array<double, N> B;
+  alignas(simd::ALIGNMENT) std::array<double, N> C;
+};
+
+
+/**
+ * @brief Return A·cos(B + C·jm) of the `simd::LANES` terms starting at `index`.
+ */
+template <std::size_t N>
+inline auto evaluate_terms(const Terms<N>& terms, const std::size_t index, const simd::VecD& vjm) -> simd::VecD {
+  const simd::VecD x = simd::load(terms.B, index) + simd::load(terms.C, index) * vjm;
+  return simd::load(terms.A, index) * simd::cos(x);
+}
+
+
+/**
+ * @brief Return the sum of A·cos(B + C·jm) over the first `COUNT` terms.
+ * @tparam COUNT The number of terms that are not padding. Only the vectors covering them are evaluated.
+ * @param terms The terms of a generated table.
+ * @param jm The julian millennium.
+ * @details All the trip counts are compile-time constants, so the compiler is free to unroll the loops,
+ *          and keeps `ACCUMULATORS` independent partial sums in registers.
+ */
+template <std::size_t COUNT, std::size_t N>
+inline auto sum_terms(const Terms<N>& terms, const double jm) -> double {
+  constexpr std::size_t VECTORS = simd::padded(COUNT) / simd::LANES;
+  constexpr std::size_t ACCUMULATORS = 4;
+  constexpr std::size_t BODY = VECTORS / ACCUMULATORS * ACCUMULATORS;
+  static_assert(VECTORS * simd::LANES <= N);
+
+  const simd::VecD vjm = simd::splat(jm);
+
+  std::array<simd::VecD, ACCUMULATORS> sums {};
+  for (std::size_t v = 0; v < BODY; v += ACCUMULATORS) {
+#pragma GCC unroll 4
+    for (std::size_t a = 0; a < ACCUMULATORS; ++a) {
+      sums[a] += evaluate_terms(terms, (v + a) * simd::LANES, vjm);
+    }
+  }
+#pragma GCC unroll 4
+  for (std::size_t a = 0; a < VECTORS - BODY; ++a) {
+    sums[a] += evaluate_terms(terms, (BODY + a) * simd::LANES, vjm);
+  }
+
+  double sum = 0.0;
+  for (const simd::VecD& partial : sums) {
+    sum = simd::accumulate(partial, sum);
+  }
+  return sum;
+}
+
+#pragma endregion
+
+
+#pragma region Generated Kernels
+
+/**
+ * @brief Evaluate the VSOP87D tables on the given julian millennium, with the generated kernel.
+ * @tparam planet The planet to evaluate.
+ * @tparam precision The precision tier, see `Precision`.
+ * @param jm The julian millennium since J2000, calculated based on JDE (julian ephemeris date).
+ * @return The evaluation result, which agrees with `vsop87d::evaluate<planet, precision>` up to rounding.
+ * @note Only the explicit specializations below exist. They are defined in the generated translation units.
+ */
+template <Planet planet, Precision precision>
+auto evaluate(double jm) -> Evaluation;
+
+template <> auto evaluate<Planet::EAR, Precision::FULL>(double jm) -> Evaluation;
+template <> auto evaluate<Planet::EAR, Precision::ARCSEC>(double jm) -> Evaluation;
+template <> auto evaluate<Planet::EAR, Precision::TEN_ARCSEC>(double jm) -> Evaluation;
+template <> auto evaluate<Planet::EAR, Precision::ARCMIN>(double jm) -> Evaluation;
+
+#pragma endregion
+
+} // namespace astro::vsop87d::kernels
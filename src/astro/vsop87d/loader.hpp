@@ -0,0 +1,421 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <format>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include "simd.hpp"
+#include "defines.hpp"
+
+// The VSOP87D tables of the planets other than the Earth, loaded at runtime from the original ASCII distribution
+// (VSOP87D.mer, VSOP87D.ven, VSOP87D.mar, VSOP87D.jup, VSOP87D.sat, VSOP87D.ura and VSOP87D.nep).
+// So they do not inflate the build time and the binary size of every translation unit that includes the library.
+//
+// A file is parsed line by line, into aligned SoA tables which the SIMD kernels evaluate just like the built-in ones.
+// Once `load<planet>` succeeds, `PlannetTables<planet>` refers to the loaded tables, so `evaluate<planet>`,
+// `evaluate_batch<planet>` and `Vsop87dStepper<planet>` work as they do for `Planet::EAR`.
+// Only `Precision::FULL` is available for the loaded planets.
+
+namespace astro::vsop87d {
+
+#pragma region Planets
+
+/** @brief Return the name of the planet, as in the headers of the VSOP87D files, e.g. "MARS". */
+constexpr auto vsop87d_name(const Planet planet) -> std::string_view {
+  switch (planet) {
+    case Planet::MER: return "MERCURY";
+    case Planet::VEN: return "VENUS";
+    case Planet::EAR: return "EARTH";
+    case Planet::MAR: return "MARS";
+    case Planet::JUP: return "JUPITER";
+    case Planet::SAT: return "SATURN";
+    case Planet::URA: return "URANUS";
+    case Planet::NEP: return "NEPTUNE";
+  }
+  return "";
+}
+
+/** @brief Return the index of the body in the VSOP87D files, i.e. 1 for Mercury, ..., 8 for Neptune. */
+constexpr auto vsop87d_index(const Planet planet) -> int {
+  switch (planet) {
+    case Planet::MER: return 1;
+    case Planet::VEN: return 2;
+    case Planet::EAR: return 3;
+    case Planet::MAR: return 4;
+    case Planet::JUP: return 5;
+    case Planet::SAT: return 6;
+    case Planet::URA: return 7;
+    case Planet::NEP: return 8;
+  }
+  return 0;
+}
+
+/** @brief Return true if the tables of the planet are loaded at runtime, i.e. not built in. */
+constexpr auto is_loadable(const Planet planet) -> bool {
+  return planet != Planet::EAR;
+}
+
+#pragma endregion
+
+
+#pragma region Loaded Tables
+
+using simd::AlignedVector;
+
+
+/**
+ * @class The VSOP87D tables of a planet, parsed at runtime, in structure-of-arrays layout.
+ * @note As in the built-in tables, the "A"s are multiplied by `SCALING_FACTOR`, and every table is zero-padded to full vectors.
+ *       The views returned by `L`, `B` and `R` stay valid as long as the object is alive, even if it is moved.
+ */
+class LoadedTables {
+public:
+  /** @brief The number of series in a planet, i.e. L, B and R. */
+  static constexpr std::size_t SERIES = 3;
+
+  /**
+   * @brief Parse a VSOP87D file, line by line.
+   * @param in The stream of the file, in the format of the original VSOP87D distribution.
+   * @param planet The planet the file is expected to hold.
+   * @throw std::runtime_error If the file is malformed, or holds another planet or another version of VSOP87.
+   */
+  static auto parse(std::istream& in, const Planet planet) -> LoadedTables {
+    LoadedTables loaded;
+    Table* table = nullptr;    // The table being read.
+    std::string code;          // The code every term of `table` starts with.
+    std::size_t expected = 0;  // The number of the terms of `table`, as declared by its header.
+    std::size_t line_number = 0;
+
+    const auto fail = [&line_number](const std::string_view reason) {
+      throw std::runtime_error { std::format("Malformed VSOP87D file at line {}: {}", line_number, reason) };
+    };
+    const auto finish_table = [&] {
+      if (table != nullptr and table->A.size() != expected) {
+        fail(std::format("expected {} terms, but got {}", expected, table->A.size()));
+      }
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+      ++line_number;
+      std::istringstream fields { line };
+      std::vector<std::string> words;
+      for (std::string word; fields >> word;) {
+        words.push_back(std::move(word));
+      }
+      if (words.empty()) {
+        continue;
+      }
+
+      if (words[0] == "VSOP87") {
+        // The header of a table, e.g.
+        // " VSOP87 VERSION D4    MARS      VARIABLE 1 (LBR)       *T**0   1164 TERMS    HELIOCENTRIC DYNAMICAL ECLIPTIC AND EQUINOX OF THE DATE"
+        finish_table();
+        const auto [variable, power, count] = parse_header(words, planet, fail);
+        auto& series = loaded._tables.at(variable);
+        if (power != series.size()) {
+          fail(std::format("expected the table of T^{}, but got T^{}", series.size(), power));
+        }
+        table = &series.emplace_back();
+        code = std::format("4{}{}{}", vsop87d_index(planet), variable + 1, power);
+        expected = count;
+        continue;
+      }
+
+      // A term. The first word holds the version (4 for VSOP87D), the body, the variable and the power, e.g. "4410".
+      // The last three words are A, B and C, of A·cos(B + C·T).
+      if (table == nullptr) {
+        fail("a term before any header");
+      }
+      if (words.size() < 5 or words[0] != code) {
+        fail(std::format("expected a term starting with {}", code));
+      }
+      table->A.push_back(parse_double(words[words.size() - 3], fail) * SCALING_FACTOR);
+      table->B.push_back(parse_double(words[words.size() - 2], fail));
+      table->C.push_back(parse_double(words[words.size() - 1], fail));
+    }
+    finish_table();
+
+    for (std::size_t i = 0; i < SERIES; ++i) {
+      if (loaded._tables.at(i).empty()) {
+        throw std::runtime_error { std::format("Malformed VSOP87D file: no tables of variable {}", i + 1) };
+      }
+    }
+
+    loaded.pad_and_view();
+    return loaded;
+  }
+
+  /**
+   * @brief Load a VSOP87D file.
+   * @param path The path to the file, e.g. "VSOP87D.mar".
+   * @param planet The planet the file is expected to hold.
+   * @throw std::runtime_error If the file cannot be read, or is malformed.
+   */
+  static auto load(const std::filesystem::path& path, const Planet planet) -> LoadedTables {
+    std::ifstream in { path };
+    if (not in) {
+      throw std::runtime_error { std::format("Failed to open {}", path.string()) };
+    }
+    return parse(in, planet);
+  }
+
+  LoadedTables(const LoadedTables&) = delete;
+  LoadedTables(LoadedTables&&) = default;
+  auto operator=(const LoadedTables&) -> LoadedTables& = delete;
+  auto operator=(LoadedTables&&) -> LoadedTables& = default;
+  ~LoadedTables() = default;
+
+  /** @brief Return the L tables, i.e. the ecliptic longitude. */
+  [[nodiscard]] auto L() const -> SoaTables { return _views.at(0); }
+
+  /** @brief Return the B tables, i.e. the ecliptic latitude. */
+  [[nodiscard]] auto B() const -> SoaTables { return _views.at(1); }
+
+  /** @brief Return the R tables, i.e. the radius. */
+  [[nodiscard]] auto R() const -> SoaTables { return _views.at(2); }
+
+  /** @brief Return the total number of terms, without the padding. */
+  [[nodiscard]] auto term_count() const -> std::size_t { return _term_count; }
+
+private:
+  LoadedTables() = default;
+
+  /** @struct The storage of a table. */
+  struct Table {
+    AlignedVector A;
+    AlignedVector B;
+    AlignedVector C;
+  };
+
+  std::array<std::vector<Table>, SERIES> _tables;
+  std::array<std::vector<SoaTable>, SERIES> _views;
+  std::size_t _term_count { 0 };
+
+  /** @struct The fields of a header. */
+  struct Header {
+    std::size_t variable; // 0 for L, 1 for B, 2 for R.
+    std::size_t power;    // The power of T.
+    std::size_t count;    // The number of terms.
+  };
+
+  /** @brief Return the value following `keyword` in the header. */
+  static auto after(const std::vector<std::string>& words, const std::string_view keyword, const auto& fail) -> std::string_view {
+    for (std::size_t i = 0; i + 1 < words.size(); ++i) {
+      if (words[i] == keyword) {
+        return words[i + 1];
+      }
+    }
+    fail(std::format("no {} in the header", keyword));
+    return "";
+  }
+
+  /** @brief Parse an unsigned integer. */
+  static auto parse_size(const std::string_view word, const auto& fail) -> std::size_t {
+    std::size_t value = 0;
+    const auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+    if (error != std::errc {} or end != word.data() + word.size()) {
+      fail(std::format("invalid integer {}", word));
+    }
+    return value;
+  }
+
+  /** @brief Parse a floating-point number. */
+  static auto parse_double(const std::string_view word, const auto& fail) -> double {
+    double value = 0.0;
+    const auto [end, error] = std::from_chars(word.data(), word.data() + word.size(), value);
+    if (error != std::errc {} or end != word.data() + word.size()) {
+      fail(std::format("invalid number {}", word));
+    }
+    return value;
+  }
+
+  /** @brief Parse and validate the header of a table. */
+  static auto parse_header(const std::vector<std::string>& words, const Planet planet, const auto& fail) -> Header {
+    // The version is "D", followed by the index of the body, e.g. "D4".
+    const std::string_view version = after(words, "VERSION", fail);
+    if (not version.starts_with('D')) {
+      fail(std::format("expected VSOP87D, but got VSOP87{}", version.substr(0, 1)));
+    }
+    if (words.size() < 4 or words[3] != vsop87d_name(planet)) {
+      fail(std::format("expected the tables of {}", vsop87d_name(planet)));
+    }
+
+    const std::size_t variable = parse_size(after(words, "VARIABLE", fail), fail);
+    if (variable < 1 or variable > SERIES) {
+      fail(std::format("invalid variable {}", variable));
+    }
+
+    // The power is written as "*T**k".
+    std::size_t power = 0;
+    std::size_t count = 0;
+    bool found = false;
+    for (std::size_t i = 0; i + 1 < words.size(); ++i) {
+      if (words[i].starts_with("*T**")) {
+        power = parse_size(std::string_view { words[i] }.substr(4), fail);
+        count = parse_size(words[i + 1], fail);
+        found = true;
+      }
+    }
+    if (not found) {
+      fail("no *T** in the header");
+    }
+
+    return { .variable = variable - 1, .power = power, .count = count };
+  }
+
+  /** @brief Pad the tables to full vectors, and create the views. */
+  void pad_and_view() {
+    for (std::size_t i = 0; i < SERIES; ++i) {
+      for (Table& table : _tables.at(i)) {
+        _term_count += table.A.size();
+        const std::size_t size = simd::padded(table.A.size());
+        table.A.resize(size, 0.0);
+        table.B.resize(size, 0.0);
+        table.C.resize(size, 0.0);
+        _views.at(i).push_back({ .A = table.A, .B = table.B, .C = table.C });
+      }
+    }
+  }
+};
+
+#pragma endregion
+
+
+#pragma region Registry
+
+/** @struct The tables of a loadable planet, registered by `load`. */
+struct LoadedPlanet {
+  std::optional<LoadedTables> tables; // Empty until loaded.
+
+  // The views of `tables`, which `PlannetTables` refers to. Empty until loaded.
+  SoaTables L;
+  SoaTables B;
+  SoaTables R;
+};
+
+/** @brief The registered tables of each loadable planet. */
+template <Planet planet>
+inline LoadedPlanet LOADED_PLANET {};
+
+/** @brief Serialize the registrations. */
+inline std::mutex LOAD_MUTEX;
+
+
+/**
+ * @brief Load the VSOP87D file of the given planet, and register its tables.
+ * @tparam planet The planet, which must not be built in.
+ * @param path The path to the file, e.g. "VSOP87D.mar".
+ * @throw std::runtime_error If the planet is already loaded, or the file cannot be loaded.
+ * @note A planet can be loaded only once, so the registered tables never change while they are evaluated.
+ *       Load the planets before evaluating them on other threads.
+ */
+template <Planet planet>
+inline void load(const std::filesystem::path& path) {
+  static_assert(is_loadable(planet), "The tables of the planet are built in.");
+
+  const std::lock_guard lock { LOAD_MUTEX };
+  LoadedPlanet& registered = LOADED_PLANET<planet>;
+  if (registered.tables.has_value()) {
+    throw std::runtime_error { std::format("The VSOP87D tables of {} are already loaded.", vsop87d_name(planet)) };
+  }
+
+  const auto& tables = registered.tables.emplace(LoadedTables::load(path, planet));
+  registered.L = tables.L();
+  registered.B = tables.B();
+  registered.R = tables.R();
+}
+
+/**
+ * @brief Load the VSOP87D file of the given planet, and register its tables.
+ * @throw std::invalid_argument If the tables of the planet are built in.
+ * @throw std::runtime_error If the planet is already loaded, or the file cannot be loaded.
+ */
+inline void load(const Planet planet, const std::filesystem::path& path) {
+  switch (planet) {
+    case Planet::EAR: break;
+    case Planet::MER: return load<Planet::MER>(path);
+    case Planet::VEN: return load<Planet::VEN>(path);
+    case Planet::MAR: return load<Planet::MAR>(path);
+    case Planet::JUP: return load<Planet::JUP>(path);
+    case Planet::SAT: return load<Planet::SAT>(path);
+    case Planet::URA: return load<Planet::URA>(path);
+    case Planet::NEP: return load<Planet::NEP>(path);
+  }
+  throw std::invalid_argument { std::format("The VSOP87D tables of {} are built in.", vsop87d_name(planet)) };
+}
+
+/** @brief Return true if the tables of the given planet are available, i.e. built in or loaded. */
+template <Planet planet>
+inline auto is_loaded() -> bool {
+  if constexpr (is_loadable(planet)) {
+    const std::lock_guard lock { LOAD_MUTEX };
+    return LOADED_PLANET<planet>.tables.has_value();
+  } else {
+    return true;
+  }
+}
+
+#pragma endregion
+
+} // namespace astro::vsop87d
+
+
+namespace astro::vsop87d {
+
+/** @brief Specialize `PlannetTables` for the planets loaded at runtime. */
+template <Planet planet>
+  requires (is_loadable(planet))
+struct PlannetTables<planet> {
+  /** @brief Return true if the tables are loaded. See `require_tables`. */
+  static auto loaded() -> bool {
+    return LOADED_PLANET<planet>.tables.has_value();
+  }
+
+  template <Precision precision>
+  struct Tier {
+    static_assert(precision == Precision::FULL, "Only the full series of the loaded planets are available.");
+
+    static constexpr const SoaTables& L = LOADED_PLANET<planet>.L;
+    static constexpr const SoaTables& B = LOADED_PLANET<planet>.B;
+    static constexpr const SoaTables& R = LOADED_PLANET<planet>.R;
+  };
+};
+
+} // namespace astro::vsop87d
@@ -0,0 +1,397 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <ranges>
+#include <algorithm>
+#include <stdexcept>
+
+#include "simd.hpp"
+#include "defines.hpp"
+#include "batch.hpp"
+
+namespace astro::vsop87d {
+
+#pragma region Series Stepping
+
+// When the epochs are evenly spaced (e.g. tabulating the Sun every minute for a year),
+// the phase `B + C * jm` of every term advances by the constant `C * Δjm` per step.
+// So instead of evaluating a cosine per term per epoch, every term is advanced with a rotation:
+//
+//   cos(x + δ) = cos(x)·cos(δ) - sin(x)·sin(δ)
+//   sin(x + δ) = sin(x)·cos(δ) + cos(x)·sin(δ)
+//
+// where cos(δ) and sin(δ) are computed once. The rounding errors of the recurrence grow linearly with the steps,
+// so the terms are re-seeded with `simd::sincos` periodically, which bounds the drift.
+
+/** @struct The options of `Vsop87dStepper`. */
+struct StepperOptions {
+  /**
+   * @brief The maximum number of steps between two re-seeds. Must be positive.
+   *        With the default error budget, the Earth's drift bound allows ~1.4e5 steps of a minute, so a year on a minute grid
+   *        (525600 steps) is re-seeded 5 times, i.e. ~12k cosines instead of ~1.3e9.
+   */
+  std::size_t reseed_interval = 131072;
+
+  /**
+   * @brief The maximum drift allowed in the evaluated λ and β (in radians) and r (in AU), compared to `evaluate`. 
+   *        Must be positive. The stepper re-seeds earlier than `reseed_interval` when necessary to stay within it.
+   */
+  double error_budget = 1e-11;
+};
+
+
+/**
+ * @brief The worst-case growth of the recurrence's error per step, in units of ε·|A|.
+ * @note 2 roundings in the rotation itself, 1 in `C * Δjm`, plus the error of `simd::sincos` on the step angle.
+ */
+constexpr double STEPPER_DRIFT_PER_STEP = 3.0 + simd::TRIG_ULP_BOUND;
+
+
+/**
+ * @class Evaluates the VSOP87D tables on the evenly spaced epochs `jm0 + n * Δjm`, for n = 0, 1, 2, ...
+ * @tparam planet The planet to evaluate.
+ * @tparam precision The precision tier, see `Precision`. Not `Precision::MIXED`, whose tail is in single precision.
+ * @details At every re-seed, the terms are evaluated exactly like `evaluate<planet, precision>`, so the results are identical there.
+ *          Between re-seeds, the results drift by no more than `StepperOptions::error_budget`.
+ * @example
+ *   Vsop87dStepper<Planet::EAR> stepper { jm0, Δjm };
+ *   for (std::size_t n = 0; n < count; ++n, stepper.step()) {
+ *     const Evaluation evaluated = stepper.evaluate();
+ *   }
+ */
+template <Planet planet, Precision precision = Precision::FULL>
+class Vsop87dStepper {
+  static_assert(precision != Precision::MIXED, "The terms are stepped in double precision only, see `Precision::MIXED`.");
+
+public:
+  /**
+   * @brief Construct the stepper, seeded at `jm0`.
+   * @param jm0 The first julian millennium.
+   * @param Δjm The step, in julian millenniums.
+   * @param options The re-seed interval and the error budget.
+   * @throw std::invalid_argument If `options.reseed_interval` is 0, or `options.error_budget` is not positive.
+   * @throw std::runtime_error If the tables of the planet are not loaded, see `require_tables`.
+   */
+  Vsop87dStepper(const double jm0, const double Δjm, const StepperOptions options = {})
+    : _jm0 { jm0 }, _Δjm { Δjm }, _options { options } {
+    if (_options.reseed_interval == 0) {
+      throw std::invalid_argument { "The re-seed interval must be positive." };
+    }
+    if (!(_options.error_budget > 0.0)) {
+      throw std::invalid_argument { "The error budget must be positive." };
+    }
+    require_tables<planet>();
+
+    using Tier = typename PlannetTables<planet>::template Tier<precision>;
+    init_series(_series[0], Tier::L);
+    init_series(_series[1], Tier::B);
+    init_series(_series[2], Tier::R);
+    reseed();
+  }
+
+  /** @brief Return the julian millennium of the current epoch. */
+  [[nodiscard]] auto jm() const -> double {
+    return _jm0 + static_cast<double>(_n) * _Δjm;
+  }
+
+  /** @brief Return the number of steps taken so far. */
+  [[nodiscard]] auto steps() const -> std::size_t {
+    return _n;
+  }
+
+  /** @brief Return the number of steps between the last re-seed and the next one. */
+  [[nodiscard]] auto reseed_interval() const -> std::size_t {
+    return _interval;
+  }
+
+  /** @brief Return the number of re-seeds so far, including the initial seeding. */
+  [[nodiscard]] auto reseeds() const -> std::size_t {
+    return _reseeds;
+  }
+
+  /**
+   * @brief Evaluate the VSOP87D tables on the current epoch. No trigonometric functions are evaluated.
+   * @return The evaluation result, same as `evaluate<planet, precision>(jm())` up to the error budget.
+   */
+  [[nodiscard]] auto evaluate() const -> Evaluation {
+    const double jm = this->jm();
+    return {
+      .λ = evaluate_series(_series[0], jm),
+      .β = evaluate_series(_series[1], jm),
+      .r = evaluate_series(_series[2], jm),
+    };
+  }
+
+  /** @brief Advance to the next epoch. */
+  void step() {
+    ++_n;
+    if (_n - _seeded_at >= _interval) {
+      reseed();
+      return;
+    }
+
+    for (auto& series : _series) {
+      for (auto& table : series) {
+        rotate(table);
+      }
+    }
+  }
+
+  /**
+   * @brief Evaluate the VSOP87D tables on the next `out.size()` epochs, and advance past them.
+   * @param out The output, where `out[i]` is the evaluation at `jm0 + (steps() + i) * Δjm`.
+   * @details Same results as calling `evaluate` and `step` alternately. 
+   *          But instead of streaming the whole state through the caches once per epoch, 
+   *          blocks of terms are kept in registers and stepped across up to `BATCH_TILE` epochs.
+   */
+  void fill(const std::span<Evaluation> out) {
+    alignas(simd::ALIGNMENT) Tile jm_tile;
+    alignas(simd::ALIGNMENT) Tile λ_tile;
+    alignas(simd::ALIGNMENT) Tile β_tile;
+    alignas(simd::ALIGNMENT) Tile r_tile;
+
+    std::size_t done = 0;
+    while (done < out.size()) {
+      // Never step across a re-seed.
+      const std::size_t count = std::min({ BATCH_TILE, out.size() - done, _interval - (_n - _seeded_at) });
+      for (std::size_t t = 0; t < count; ++t) {
+        jm_tile[t] = _jm0 + static_cast<double>(_n + t) * _Δjm;
+      }
+
+      fill_series(_series[0], jm_tile, count, λ_tile);
+      fill_series(_series[1], jm_tile, count, β_tile);
+      fill_series(_series[2], jm_tile, count, r_tile);
+
+      for (std::size_t t = 0; t < count; ++t) {
+        out[done + t] = { .λ = λ_tile[t], .β = β_tile[t], .r = r_tile[t] };
+      }
+
+      done += count;
+      _n += count;
+      if (_n - _seeded_at >= _interval) {
+        reseed();
+      }
+    }
+  }
+
+private:
+  /** @struct The state of the terms in a table. */
+  struct TableState {
+    SoaTable table;
+    std::vector<double> cos;      // cos(B + C * jm), per term
+    std::vector<double> sin;      // sin(B + C * jm), per term
+    std::vector<double> cos_step; // cos(C * Δjm), per term
+    std::vector<double> sin_step; // sin(C * Δjm), per term
+    double amplitude;             // Σ|A| of the non-constant terms, scaled to radians (or AU)
+  };
+
+  using Series = std::vector<TableState>;
+
+  void init_series(Series& series, const SoaTables& soa_tables) const {
+    series.reserve(soa_tables.size());
+    for (const SoaTable& soa_table : soa_tables) {
+      const std::size_t size = soa_table.A.size();
+      TableState& state = series.emplace_back(TableState {
+        .table = soa_table,
+        .cos = std::vector<double>(size),
+        .sin = std::vector<double>(size),
+        .cos_step = std::vector<double>(size),
+        .sin_step = std::vector<double>(size),
+        .amplitude = 0.0,
+      });
+
+      const simd::VecD vΔjm = simd::splat(_Δjm);
+      for (std::size_t i = 0; i < size; i += simd::LANES) {
+        const auto [s, c] = simd::sincos(simd::load(soa_table.C, i) * vΔjm);
+        simd::store(state.sin_step, i, s);
+        simd::store(state.cos_step, i, c);
+      }
+
+      // Terms with C = 0 are constant, their rotations are exact and never drift.
+      for (std::size_t i = 0; i < size; ++i) {
+        state.amplitude += soa_table.C[i] == 0.0 ? 0.0 : std::abs(soa_table.A[i]);
+      }
+      state.amplitude /= SCALING_FACTOR;
+    }
+  }
+
+  static void seed(TableState& state, const double jm) {
+    const simd::VecD vjm = simd::splat(jm);
+    for (std::size_t i = 0; i < state.table.A.size(); i += simd::LANES) {
+      const simd::VecD x = simd::load(state.table.B, i) + simd::load(state.table.C, i) * vjm;
+      const auto [s, c] = simd::sincos(x);
+      simd::store(state.sin, i, s);
+      simd::store(state.cos, i, c);
+    }
+  }
+
+  static void rotate(TableState& state) {
+    for (std::size_t i = 0; i < state.table.A.size(); i += simd::LANES) {
+      const simd::VecD c = simd::load(state.cos, i);
+      const simd::VecD s = simd::load(state.sin, i);
+      const simd::VecD cδ = simd::load(state.cos_step, i);
+      const simd::VecD sδ = simd::load(state.sin_step, i);
+      simd::store(state.cos, i, c * cδ - s * sδ);
+      simd::store(state.sin, i, s * cδ + c * sδ);
+    }
+  }
+
+  /**
+   * @brief Step `NV` vectors of terms, starting at term `i`, across `count` epochs.
+   * @note The terms are added to the per-epoch accumulators in table order, exactly like `evaluate_series`.
+   */
+  template <std::size_t NV>
+  static void fill_block(TableState& state, const std::size_t i, const std::size_t count, Tile& acc) {
+    std::array<simd::VecD, NV> A, c, s, cδ, sδ;
+    #pragma GCC unroll 8
+    for (std::size_t v = 0; v < NV; ++v) {
+      const std::size_t index = i + v * simd::LANES;
+      A[v] = simd::load(state.table.A, index);
+      c[v] = simd::load(state.cos, index);
+      s[v] = simd::load(state.sin, index);
+      cδ[v] = simd::load(state.cos_step, index);
+      sδ[v] = simd::load(state.sin_step, index);
+    }
+
+    for (std::size_t t = 0; t < count; ++t) {
+      #pragma GCC unroll 8
+      for (std::size_t v = 0; v < NV; ++v) {
+        acc[t] = simd::accumulate(A[v] * c[v], acc[t]);
+
+        const simd::VecD rotated_c = c[v] * cδ[v] - s[v] * sδ[v];
+        s[v] = s[v] * cδ[v] + c[v] * sδ[v];
+        c[v] = rotated_c;
+      }
+    }
+
+    #pragma GCC unroll 8
+    for (std::size_t v = 0; v < NV; ++v) {
+      const std::size_t index = i + v * simd::LANES;
+      simd::store(state.cos, index, c[v]);
+      simd::store(state.sin, index, s[v]);
+    }
+  }
+
+  static void fill_series(Series& series, const Tile& jms, const std::size_t count, Tile& results) {
+    // The independent blocks of terms give the CPU several rotation dependency chains to overlap.
+    constexpr std::size_t BLOCK_VECTORS = 4;
+    constexpr std::size_t BLOCK = BLOCK_VECTORS * simd::LANES;
+
+    alignas(simd::ALIGNMENT) Tile acc;
+    results.fill(0.0);
+
+    // Same as `evaluate_series`.
+    for (TableState& state : std::views::reverse(series)) {
+      acc.fill(0.0);
+
+      const std::size_t size = state.table.A.size();
+      std::size_t i = 0;
+      for (; i + BLOCK <= size; i += BLOCK) {
+        fill_block<BLOCK_VECTORS>(state, i, count, acc);
+      }
+      for (; i < size; i += simd::LANES) {
+        fill_block<1>(state, i, count, acc);
+      }
+
+      for (std::size_t t = 0; t < count; ++t) {
+        results[t] = results[t] * jms[t] + acc[t] / SCALING_FACTOR;
+      }
+    }
+  }
+
+  static auto evaluate_series(const Series& series, const double jm) -> double {
+    // Same as `evaluate_tables`, the table results are accumulated in reverse order (Horner's method),
+    // and the terms in a table are accumulated in table order.
+    double accumulated = 0.0;
+    for (const TableState& state : std::views::reverse(series)) {
+      double sum = 0.0;
+      for (std::size_t i = 0; i < state.table.A.size(); i += simd::LANES) {
+        sum = simd::accumulate(simd::load(state.table.A, i) * simd::load(state.cos, i), sum);
+      }
+      accumulated = accumulated * jm + sum / SCALING_FACTOR;
+    }
+    return accumulated;
+  }
+
+  /** 
+   * @brief Return the worst-case drift per step of a series, for |jm| up to `jm_bound`. 
+   * @note Through Horner's method, the drift of the k-th table is multiplied by |jm|^k.
+   */
+  static auto drift_per_step(const Series& series, const double jm_bound) -> double {
+    constexpr double ε = std::numeric_limits<double>::epsilon();
+
+    double drift = 0.0;
+    double power = 1.0;
+    for (const TableState& state : series) {
+      drift += STEPPER_DRIFT_PER_STEP * ε * state.amplitude * power;
+      power *= jm_bound;
+    }
+    return drift;
+  }
+
+  void reseed() {
+    const double jm = this->jm();
+    for (auto& series : _series) {
+      for (auto& table : series) {
+        seed(table, jm);
+      }
+    }
+    _seeded_at = _n;
+    ++_reseeds;
+
+    // Shorten the interval if the worst-case drift would exceed the budget within it.
+    const double span = static_cast<double>(_options.reseed_interval) * std::abs(_Δjm);
+    const double jm_bound = std::abs(jm) + span;
+
+    double max_drift = 0.0;
+    for (const auto& series : _series) {
+      max_drift = std::max(max_drift, drift_per_step(series, jm_bound));
+    }
+
+    const double allowed = std::floor(_options.error_budget / max_drift);
+    _interval = allowed < static_cast<double>(_options.reseed_interval) 
+              ? std::max<std::size_t>(1, static_cast<std::size_t>(allowed)) 
+              : _options.reseed_interval;
+  }
+
+  double _jm0;
+  double _Δjm;
+  StepperOptions _options;
+
+  std::array<Series, 3> _series {}; // L, B, R
+  std::size_t _n { 0 };
+  std::size_t _seeded_at { 0 };
+  std::size_t _interval { 0 };
+  std::size_t _reseeds { 0 };
+};
+
+#pragma endregion
+
+} // namespace astro::vsop87d
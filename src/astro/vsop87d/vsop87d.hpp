@@ -23,3 +23,6 @@
 
 #include "defines.hpp"
 #include "earth_coeff.hpp"
+#include "loader.hpp"
+#include "batch.hpp"
+#include "stepper.hpp"
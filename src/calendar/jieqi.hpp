@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include <array>
+#include <cmath>
+#include <utility>
+#include <algorithm>
 #include <unordered_map>
 
 #include "util.hpp"
@@ -153,8 +157,77 @@ inline auto calc_jieqi_jde(const int32_t year, const Jieqi jq) -> double {
 }
 
 
-/** @brief Simply a cached version of `calc_jieqi_jde`. */
-const inline auto jieqi_jde = util::cache::cache_func(calc_jieqi_jde);
+/**
+ * @brief Get the JDEs of all the jieqis in the given `year`, in one sweep.
+ * @param year The year, in gregorian calendar.
+ * @param max_iter The maximum number of Newton iterations per jieqi, see `refine_root`. Default is 8.
+ * @return The JDEs (Julian Ephemeris Days), indexed by `to_index`.
+ * @throw std::runtime_error If a jieqi does not converge, since the later ones would be estimated from it.
+ * @details The same roots as `calc_jieqi_jde`, within ~1e-9 day. The jieqis are solved in the order of their occurrence,
+ *          and the bounds of the year are evaluated once for all of them.
+ *          Every jieqi is estimated from the one before it, ~15.2 days earlier, see `estimate_root`,
+ *          so Newton's method mostly settles in 1 or 2 iterations.
+ */
+inline auto solve_year_jieqis(const int32_t year, const std::size_t max_iter = 8) -> std::array<double, JIEQI_COUNT> {
+  namespace math = astro::sun::geocentric_coord::math;
+  const auto bounds = math::year_bounds(year);
+
+  // The longitude travelled by the Sun since the start of the year, when each jieqi occurs, as in `find_roots`.
+  // Near the end of the 9th millennium, 小寒 moves from the start to the end of the year, so the occurrence order is sorted out here.
+  std::array<std::pair<double, Jieqi>, JIEQI_COUNT> occurrences {};
+  for (const auto jq : JIEQI_LIST) {
+    const auto lon = JIEQI_SOLAR_LONGITUDE.at(jq);
+
+    // The same count as `discriminant`, for the bounds evaluated already.
+    const bool before_spring_equinox = math::has_root_before_spring_equinox(bounds, lon);
+    const bool after_spring_equinox = math::has_root_after_spring_equinox(bounds, lon);
+    if (before_spring_equinox == after_spring_equinox) {
+      throw std::runtime_error {
+        std::vformat("Unexpected roots size for year {}, jieqi {}", 
+                     std::make_format_args(year, JIEQI_NAME.at(jq)))
+      };
+    }
+
+    // Slightly negative for a root just after the start, when the low accuracy `start_lon` overshoots it.
+    const double travelled = before_spring_equinox ? lon - bounds.start_lon : lon + 360.0 - bounds.start_lon;
+    occurrences[to_index(jq)] = { travelled, jq };
+  }
+  std::ranges::sort(occurrences);
+
+  std::array<double, JIEQI_COUNT> jdes {};
+  double anchor_jde = bounds.start_jde;
+  double anchor_lon = bounds.start_lon;
+  double anchor_travelled = 0.0;
+
+  for (const auto& [travelled, jq] : occurrences) {
+    const auto lon = JIEQI_SOLAR_LONGITUDE.at(jq);
+
+    // Estimated from the previous jieqi (or the start of the year), which is 15° behind except for the first one.
+    const double estimate = bounds.clamp(math::estimate_root(anchor_jde, anchor_lon, travelled - anchor_travelled));
+
+    anchor_jde = math::refine_root(bounds, lon, estimate, max_iter);
+    anchor_lon = lon;
+    anchor_travelled = travelled;
+    jdes[to_index(jq)] = anchor_jde;
+  }
+
+  return jdes;
+}
+
+
+/** @brief Simply a cached version of `solve_year_jieqis`. */
+const inline auto year_jieqis = util::cache::cache_func([](const int32_t year) { return solve_year_jieqis(year); });
+
+
+/**
+ * @brief Get the JDE for the given `year` and `jieqi`, from the cached sweep of the year, see `solve_year_jieqis`.
+ * @param year The year, in gregorian calendar.
+ * @param jq The jieqi.
+ * @return The JDE (Julian Ephemeris Day).
+ */
+inline auto jieqi_jde(const int32_t year, const Jieqi jq) -> double {
+  return year_jieqis(year)[to_index(jq)];
+}
 
 
 /**
@@ -179,10 +252,32 @@ private:
 
 public:
   explicit JieqiGenerator(const double start_jde) {
+    namespace math = astro::sun::geocentric_coord::math;
+
     const auto start_ut1 = astro::julian_day::jde_to_ut1(start_jde);
     const auto start_year = start_ut1.year();
 
-    // Find the first Jieqi after the given JDE.
+    // Classify the JDE by the low accuracy longitude, when it is clear of every jieqi. See `math::guarded_longitude`.
+    // Every 15° since `Jieqi::小寒` (285°) is a jieqi, so the next one is counted from the longitude travelled since then.
+    const double low_lon = math::low_accuracy_longitude(start_jde);
+    const double travelled = astro::toolbox::normalize_deg(low_lon - JIEQI_SOLAR_LONGITUDE.at(Jieqi::小寒));
+    const double nearest_jieqi_lon = JIEQI_SOLAR_LONGITUDE.at(Jieqi::小寒) + 15.0 * std::round(travelled / 15.0);
+    if (math::low_accuracy_clear_of(start_jde, low_lon, nearest_jieqi_lon)) {
+      // The index of the next one in `GREGORIAN_YEAR_JIEQI_LIST`.
+      const auto gregorian_index = static_cast<uint8_t>(travelled / 15.0) + 1;
+
+      if (gregorian_index < JIEQI_COUNT) {
+        _year = start_year;
+        _jq_index = static_cast<uint8_t>((to_index(Jieqi::小寒) + gregorian_index) % JIEQI_COUNT);
+      } else {
+        // Between `Jieqi::冬至` and `Jieqi::小寒`, the next one is `Jieqi::小寒`, of next year if still in December.
+        _year = start_ut1.month() == 1 ? start_year : start_year + 1;
+        _jq_index = to_index(Jieqi::小寒);
+      }
+      return;
+    }
+
+    // Otherwise, find the first Jieqi after the given JDE.
     _year = start_year;
     for (const auto jq : GREGORIAN_YEAR_JIEQI_LIST) {
       const auto jde = jieqi_jde(_year, jq);
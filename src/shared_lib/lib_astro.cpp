@@ -21,6 +21,7 @@
  * along with this project. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <span>
 #include <algorithm>
 
 #include "lib.hpp"
@@ -203,6 +204,40 @@ auto moon_apparent_geocentric_coord(const double jde) -> MoonCoordinate {
   }
 }
 
+
+/**
+ * @brief Calculate the apparent geocentric positions of the Moon for many epochs at once.
+ *        The results are written to the provided arrays. It's caller's responsibility to allocate and free the arrays.
+ * @param jdes The julian ephemeris day numbers, which are based on TT.
+ * @param count The count of `jdes`, and the length of each output array.
+ * @param lons The output longitudes. In degrees.
+ * @param lats The output latitudes. In degrees.
+ * @param rs The output radii. In KM.
+ * @return How many positions are written, which is 0 on error.
+ */
+auto moon_apparent_geocentric_coords(
+  const double * const jdes,
+  const uint32_t count,
+  double * const lons,
+  double * const lats,
+  double * const rs
+) -> uint32_t {
+  try {
+    astro::moon::geocentric_coord::apparent_batch(
+      { jdes, count }, 
+      { lons, count }, 
+      { lats, count }, 
+      {   rs, count }
+    );
+    return count;
+  } catch (const std::exception& e) {
+    lib::info("Error in moon_apparent_geocentric_coords: {}", e.what());
+    lib::debug("moon_apparent_geocentric_coords: count = {}", count);
+
+    return 0;
+  }
+}
+
 #pragma endregion
 
 
@@ -347,6 +382,40 @@ auto new_moons_in_year(
   }
 }
 
+/**
+ * @brief Find the principal phases of the Moon (new moon, first quarter, full moon and last quarter) at or after `jde`.
+ *        The results are written to the provided slots. It's caller's responsibility to allocate and free the slots.
+ * @param jde The julian ephemeris day number, which is based on TT.
+ * @param phases The slots for the phases, 0 to 3 for new moon, first quarter, full moon and last quarter.
+ * @param jdes The slots for the moments of the phases, in JDE.
+ * @param slot_count The count of slots of both `phases` and `jdes`.
+ * @return How many slots are written.
+ */
+auto moon_phases_after_jde(
+  const double jde, 
+  uint8_t * const phases, 
+  double * const jdes, 
+  const uint32_t slot_count
+) -> uint32_t {
+  try {
+    const std::span<uint8_t> phase_slots { phases, slot_count };
+    const std::span<double> jde_slots { jdes, slot_count };
+
+    astro::moon_phase::PhaseGenerator gen(jde);
+    for (uint32_t i = 0; i < slot_count; ++i) {
+      const auto moment = gen.next();
+      phase_slots[i] = static_cast<uint8_t>(moment.phase);
+      jde_slots[i] = moment.jde;
+    }
+    return slot_count;
+  } catch (const std::exception& e) {
+    lib::info("Exception thrown during execution of moon_phases_after_jde");
+    lib::debug("moon_phases_after_jde: jde = {}, error = {}", jde, e.what());
+
+    return 0;
+  }
+}
+
 #pragma endregion
 
 }
@@ -79,6 +79,23 @@ TEST(Earth, Vsop87dEvaluate) {
   }
 }
 
+TEST(Earth, Vsop87dBatch) {
+  std::vector<double> jdes(1000);
+  for (auto& jde : jdes) {
+    jde = julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+  }
+
+  const auto coords = heliocentric_coord::vsop87d_batch(jdes);
+  ASSERT_EQ(coords.size(), jdes.size());
+
+  for (std::size_t i = 0; i < jdes.size(); ++i) {
+    const auto& [λ, β, r] = heliocentric_coord::vsop87d(jdes[i]);
+    ASSERT_DOUBLE_EQ(coords[i].λ.deg(), λ.deg());
+    ASSERT_DOUBLE_EQ(coords[i].β.deg(), β.deg());
+    ASSERT_DOUBLE_EQ(coords[i].r.au(),  r.au());
+  }
+}
+
 TEST(Earth, NutationMeeus) {
   using namespace nutation;
 
@@ -468,6 +485,151 @@ TEST(Earth, NutationIau1980) {
   }
 }
 
+TEST(Earth, NutationIau2000b) {
+  using namespace nutation;
+
+  // The test case of SOFA's `t_nut00b`, in radians: TT 2006-01-01 0h, JDE = 2453736.5.
+  const auto [Δψ, Δε] = compute(2453736.5, Model::IAU_2000B);
+  ASSERT_NEAR(Δψ.as<RAD>(), -0.9632552291148362783e-5, 1e-13);
+  ASSERT_NEAR(Δε.as<RAD>(),  0.4063197106621159367e-4, 1e-13);
+
+  for (auto i = 0; i < 100; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-36525.0, 36525.0);
+    const auto [Δψ_2000b, Δε_2000b] = compute(jde, Model::IAU_2000B);
+
+    // The same as a trigonometric call per term, in the order of the table.
+    const double jc = astro::julian_day::jde_to_jc(jde);
+    const auto [D, M, Mp, F, Ω] = iau2000b_arguments(jc);
+    double Δψ_sum = 0.0;
+    double Δε_sum = 0.0;
+    for (const auto& [θ, ψ, ε] : IAU2000B_NUTATION_COEFFS) {
+      const double arg = θ.D * D + θ.M * M + θ.Mp * Mp + θ.F * F + θ.Ω * Ω;
+      Δψ_sum += (ψ.coeff1 + ψ.coeff2 * jc) * std::sin(arg) + ψ.coeff3 * std::cos(arg);
+      Δε_sum += (ε.coeff1 + ε.coeff2 * jc) * std::cos(arg) + ε.coeff3 * std::sin(arg);
+    }
+    ASSERT_NEAR(Δψ_2000b.deg() * 3600.0, Δψ_sum * 1e-7 + IAU2000B_PLANETARY_Δψ, 1e-9) << "jde = " << jde;
+    ASSERT_NEAR(Δε_2000b.deg() * 3600.0, Δε_sum * 1e-7 + IAU2000B_PLANETARY_Δε, 1e-9) << "jde = " << jde;
+
+    // IAU 1980 differs by tens of milliarcseconds within a century of J2000.
+    const auto [Δψ_1980, Δε_1980] = compute(jde, Model::IAU_1980);
+    ASSERT_NEAR(Δψ_2000b.deg() * 3600.0, Δψ_1980.deg() * 3600.0, 0.1) << "jde = " << jde;
+    ASSERT_NEAR(Δε_2000b.deg() * 3600.0, Δε_1980.deg() * 3600.0, 0.1) << "jde = " << jde;
+
+    // The specialized kernel and the SIMD kernel agree within rounding, whichever `compute` picks.
+    ASSERT_NEAR(compute<Model::IAU_2000B>(jde).Δψ.deg(), compute_iau2000b(jc).Δψ.deg(), 1e-15);
+    ASSERT_NEAR(compute<Model::IAU_2000B>(jde).Δε.deg(), compute_iau2000b(jc).Δε.deg(), 1e-15);
+
+    // The standalone and the vector functions agree with `compute`.
+    ASSERT_EQ(longitude(jde, Model::IAU_2000B).deg(), Δψ_2000b.deg());
+    ASSERT_EQ(nutation::obliquity(jde, Model::IAU_2000B).deg(), Δε_2000b.deg());
+    const simd::VecD Δψ_vec = longitude(simd::splat(jde), Model::IAU_2000B);
+    for (std::size_t lane = 0; lane < simd::LANES; ++lane) {
+      ASSERT_EQ(Δψ_vec[lane], Δψ_2000b.deg());
+    }
+  }
+
+  // The terms are not in the layout of the other models.
+  ASSERT_TRUE(find_model(Model::IAU_2000B).empty());
+}
+
+TEST(Earth, NutationCompute) {
+  using namespace nutation;
+
+  for (const Model model : { Model::MEEUS, Model::IAU_1980 }) {
+    for (auto i = 0; i < 100; ++i) {
+      const double jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+      const auto [Δψ, Δε] = compute(jde, model);
+
+      // The standalone functions delegate to `compute`.
+      ASSERT_EQ(Δψ.deg(), longitude(jde, model).deg());
+      ASSERT_EQ(Δε.deg(), nutation::obliquity(jde, model).deg());
+
+      // Same as a trigonometric call per term, within rounding. The unit of the sums is 0".0001.
+      const double jc = astro::julian_day::jde_to_jc(jde);
+      const auto eval_θ = gen_eval_θ(jc);
+      double Δψ_sum = 0.0;
+      double Δε_sum = 0.0;
+      for (const NutationCoeffs& coeffs : find_model(model)) {
+        const double θ = eval_θ(coeffs.θ).rad();
+        Δψ_sum += (coeffs.Δψ.coeff1 + coeffs.Δψ.coeff2 * jc) * std::sin(θ);
+        Δε_sum += (coeffs.Δε.coeff1 + coeffs.Δε.coeff2 * jc) * std::cos(θ);
+      }
+      ASSERT_NEAR(Δψ.deg() * 3600.0, Δψ_sum * 0.0001, 1e-9) << "jde = " << jde;
+      ASSERT_NEAR(Δε.deg() * 3600.0, Δε_sum * 0.0001, 1e-9) << "jde = " << jde;
+    }
+  }
+}
+
+TEST(Earth, NutationWithRate) {
+  using namespace nutation;
+
+  for (const Model model : { Model::MEEUS, Model::IAU_1980, Model::IAU_2000B }) {
+    for (auto i = 0; i < 100; ++i) {
+      const double jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+      const auto [value, Δψ_rate, Δε_rate] = compute_with_rate(jde, model);
+
+      // Same value as `compute`.
+      const auto [Δψ, Δε] = compute(jde, model);
+      ASSERT_DOUBLE_EQ(value.Δψ.deg(), Δψ.deg());
+      ASSERT_DOUBLE_EQ(value.Δε.deg(), Δε.deg());
+
+      // The rates match a central difference, in degrees per day.
+      // The truncation error of the difference is about 2e-10, and the rounding error of the series about 1e-11.
+      constexpr double h = 1e-2;
+      const auto before = compute(jde - h, model);
+      const auto after  = compute(jde + h, model);
+      ASSERT_NEAR(Δψ_rate, (after.Δψ - before.Δψ).deg() / (2.0 * h), 1e-9) << "jde = " << jde;
+      ASSERT_NEAR(Δε_rate, (after.Δε - before.Δε).deg() / (2.0 * h), 1e-9) << "jde = " << jde;
+    }
+  }
+}
+
+TEST(Earth, NutationInterpolator) {
+  using namespace nutation;
+
+  const double start_jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+  const double end_jde = start_jde + 365.25;
+  const NutationInterpolator interpolator { start_jde, end_jde };
+  ASSERT_EQ(interpolator.start_jde(), start_jde);
+  ASSERT_GE(interpolator.end_jde(), end_jde);
+  ASSERT_TRUE(interpolator.covers(start_jde));
+  ASSERT_TRUE(interpolator.covers(end_jde));
+  ASSERT_FALSE(interpolator.covers(start_jde - 1.0));
+
+  // Within the error bound in the range, including both ends.
+  constexpr double bound = NutationInterpolator::ERROR_BOUND / 3600.0; // In degrees.
+  for (auto i = 0; i <= 10000; ++i) {
+    const double jde = start_jde + (end_jde - start_jde) * i / 10000.0;
+    const auto [Δψ, Δε] = interpolator.compute(jde);
+    const auto expected = compute(jde);
+    ASSERT_NEAR(Δψ.deg(), expected.Δψ.deg(), bound) << "jde = " << jde;
+    ASSERT_NEAR(Δε.deg(), expected.Δε.deg(), bound) << "jde = " << jde;
+    ASSERT_EQ(interpolator.longitude(jde).deg(), Δψ.deg());
+  }
+
+  // Exact at the nodes, and evaluated in full out of the range.
+  ASSERT_DOUBLE_EQ(interpolator.compute(start_jde).Δψ.deg(), compute(start_jde).Δψ.deg());
+  for (const double jde : { start_jde - 10.0, end_jde + 10.0 }) {
+    ASSERT_EQ(interpolator.compute(jde).Δψ.deg(), compute(jde).Δψ.deg());
+    ASSERT_EQ(interpolator.compute(jde).Δε.deg(), compute(jde).Δε.deg());
+  }
+
+  // The longest step still meets the bound, with the Meeus model as well.
+  const NutationInterpolator coarse { start_jde, end_jde, NutationInterpolator::MAX_STEP, Model::MEEUS };
+  ASSERT_EQ(coarse.model(), Model::MEEUS);
+  for (auto i = 0; i < 1000; ++i) {
+    const double jde = util::random(start_jde, end_jde);
+    ASSERT_NEAR(coarse.compute(jde).Δψ.deg(), compute(jde, Model::MEEUS).Δψ.deg(), bound) << "jde = " << jde;
+    ASSERT_NEAR(coarse.compute(jde).Δε.deg(), compute(jde, Model::MEEUS).Δε.deg(), bound) << "jde = " << jde;
+  }
+
+  // Invalid ranges and steps.
+  ASSERT_THROW(NutationInterpolator(start_jde, start_jde), std::invalid_argument);
+  ASSERT_THROW(NutationInterpolator(end_jde, start_jde), std::invalid_argument);
+  ASSERT_THROW(NutationInterpolator(start_jde, end_jde, 0.0), std::invalid_argument);
+  ASSERT_THROW(NutationInterpolator(start_jde, end_jde, 2.0), std::invalid_argument);
+}
+
 TEST(Earth, ObliquityMeeus22a) {
   using namespace obliquity;
 
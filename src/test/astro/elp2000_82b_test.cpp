@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "random.hpp"
 #include "julian_day.hpp"
 #include "elp2000_82b.hpp"
 
@@ -63,5 +64,32 @@ TEST(Elp2000, Evaluate) {
   }
 }
 
+TEST(Elp2000, EvaluateHarmonic) {
+  for (int i = 0; i < 10000; i++) {
+    const double jc = util::random(-100.0, 100.0);
+
+    const auto expected = evaluate(jc);
+    const auto evaluated = evaluate_harmonic(jc);
+    ASSERT_NEAR(evaluated.Σl, expected.Σl, HARMONIC_TOLERANCE) << "jc = " << jc;
+    ASSERT_NEAR(evaluated.Σb, expected.Σb, HARMONIC_TOLERANCE) << "jc = " << jc;
+    ASSERT_NEAR(evaluated.Σr, expected.Σr, HARMONIC_TOLERANCE) << "jc = " << jc;
+
+    // The context is the same.
+    ASSERT_EQ(evaluated.ctx.jc, expected.ctx.jc);
+    ASSERT_EQ(evaluated.ctx.Lp.deg(), expected.ctx.Lp.deg());
+    ASSERT_EQ(evaluated.ctx.E, expected.ctx.E);
+  }
+
+  // The harmonics are exact at k = 0 and k = ±1.
+  const Harmonics harmonics = make_harmonics(Angle<DEG> { 30.0 });
+  ASSERT_EQ(harmonics[0].sin, 0.0);
+  ASSERT_EQ(harmonics[0].cos, 1.0);
+  ASSERT_EQ(harmonics[1].sin, std::sin(Angle<DEG> { 30.0 }.rad()));
+  ASSERT_EQ(harmonics[-1].sin, -harmonics[1].sin);
+  for (int32_t k = -MAX_MULTIPLIER; k <= MAX_MULTIPLIER; ++k) {
+    ASSERT_NEAR(harmonics[k].sin, std::sin(k * Angle<DEG> { 30.0 }.rad()), 1e-15);
+    ASSERT_NEAR(harmonics[k].cos, std::cos(k * Angle<DEG> { 30.0 }.rad()), 1e-15);
+  }
+}
 
 } // namespace astro::elp2000_82b::test
\ No newline at end of file
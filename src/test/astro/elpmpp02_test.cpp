@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <format>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include "random.hpp"
+#include "julian_day.hpp"
+#include "elp2000_82b.hpp"
+#include "moon.hpp"
+#include "elpmpp02/elpmpp02.hpp"
+
+namespace astro::elpmpp02::test {
+
+/** @brief The perturbation terms written by `write_files`, as (variable, power, term). */
+const std::array<std::tuple<std::size_t, std::size_t, PerturbationTerm>, 3> PERTURBATIONS {{
+  { 0, 0, { .multipliers = { 0, 0, 0, 0, 0, 18, -16, 0, 0, 0, 0, 0, 0 }, .S = 0.0123, .C = -0.0045 } }, // Venus and the EMB.
+  { 1, 1, { .multipliers = { 2, 0, -1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 }, .S = -0.0031, .C = 0.0007 } },  // Jupiter.
+  { 2, 0, { .multipliers = { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 }, .S = 0.0, .C = 0.25 } },         // ζ.
+}};
+
+/**
+ * @brief Write the terms of Meeus (see `elp2000_82b.hpp`) in the format of the ELP/MPP02 distribution files,
+ *        with a few perturbation terms, i.e. the truncation of Meeus as an ELP/MPP02 theory.
+ * @return The contents of ELP_MAIN.S1, ELP_MAIN.S2, ELP_MAIN.S3, ELP_PERT.S1, ELP_PERT.S2 and ELP_PERT.S3.
+ * @note The columns follow the FORTRAN formats of the distribution: 4i3,2x,f13.5,6f12.2 and i5,2d20.13,13i3.
+ *       Meeus's multipliers are in the order of D, M, M' and F, and ELP/MPP02's are D, F, l (M') and l' (M).
+ */
+auto write_files() -> std::array<std::string, 6> {
+  using namespace astro::elp2000_82b::coeff;
+
+  const auto main_term = [](const int32_t D, const int32_t M, const int32_t Mp, const int32_t F, const double A) {
+    return std::format("{:3}{:3}{:3}{:3}  {:13.5f}{:12.2f}{:12.2f}{:12.2f}{:12.2f}{:12.2f}{:12.2f}\n", D, F, Mp, M, A, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  };
+  const auto main_header = [](const std::string_view name, const std::size_t count) {
+    return std::format("{:<25}{:10}\n", name, count);
+  };
+
+  std::array<std::string, 6> files;
+  files[0] = main_header(" MAIN PROBLEM. LONGITUDE", LR.size());
+  files[1] = main_header(" MAIN PROBLEM. LATITUDE", B.size());
+  files[2] = main_header(" MAIN PROBLEM. DISTANCE", LR.size() + 1) + main_term(0, 0, 0, 0, 385000.56);
+  for (const auto& [D, M, Mp, F, argL, argR] : LR) {
+    files[0] += main_term(D, M, Mp, F, argL * 1e-6 * 3600.0);
+    files[2] += main_term(D, M, Mp, F, argR * 1e-3);
+  }
+  for (const auto& [D, M, Mp, F, argB] : B) {
+    files[1] += main_term(D, M, Mp, F, argB * 1e-6 * 3600.0);
+  }
+
+  for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+    std::string& file = files.at(3 + variable);
+    for (std::size_t power = 0; power < POWERS; ++power) {
+      std::string terms;
+      std::size_t count = 0;
+      for (const auto& [v, p, term] : PERTURBATIONS) {
+        if (v != variable or p != power) {
+          continue;
+        }
+        terms += std::format("{:5}{:20.13E}{:20.13E}", ++count, term.S, term.C);
+        for (const int8_t multiplier : term.multipliers) {
+          terms += std::format("{:3}", multiplier);
+        }
+        terms += '\n';
+      }
+      std::string header = std::format("{:<25}{:10}{:10}\n", " PERTURBATIONS", count, power);
+      file += header + terms;
+    }
+  }
+
+  // The FORTRAN exponents.
+  for (std::size_t i = 3; i < files.size(); ++i) {
+    std::ranges::replace(files.at(i), 'E', 'D');
+  }
+  return files;
+}
+
+/** @brief Parse the files of `write_files`. */
+auto parse_files(const std::array<std::string, 6>& files) -> Coefficients {
+  Coefficients coefficients;
+  for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+    std::istringstream main { files.at(variable) };
+    coefficients.main.at(variable) = parse_main(main);
+    std::istringstream perturbation { files.at(3 + variable) };
+    coefficients.perturbation.at(variable) = parse_perturbation(perturbation);
+  }
+  return coefficients;
+}
+
+
+TEST(Elpmpp02, Parse) {
+  const auto files = write_files();
+  const auto coefficients = parse_files(files);
+  ASSERT_EQ(coefficients.term_count(), 60U + 60U + 61U + PERTURBATIONS.size());
+  ASSERT_EQ(coefficients.main[0].size(), 60U);
+  ASSERT_EQ(coefficients.main[2].size(), 61U);
+
+  // The multipliers are reordered to D, F, l, l'.
+  const MainTerm& evection = coefficients.main[0][1];
+  ASSERT_EQ(evection.multipliers, (std::array<int8_t, 4> { 2, 0, -1, 0 }));
+  ASSERT_NEAR(evection.A, 1.274027 * 3600.0, 1e-5);
+
+  for (const auto& [variable, power, expected] : PERTURBATIONS) {
+    const auto& terms = coefficients.perturbation.at(variable).at(power);
+    ASSERT_EQ(terms.size(), 1U);
+    ASSERT_EQ(terms[0].multipliers, expected.multipliers);
+    ASSERT_DOUBLE_EQ(terms[0].S, expected.S);
+    ASSERT_DOUBLE_EQ(terms[0].C, expected.C);
+  }
+
+  // Malformed files are rejected.
+  const auto parse_main_text = [](const std::string& text) {
+    std::istringstream in { text };
+    return parse_main(in);
+  };
+  const auto parse_perturbation_text = [](const std::string& text) {
+    std::istringstream in { text };
+    return parse_perturbation(in);
+  };
+  const std::string& main = files[0];
+  const std::string& perturbation = files[3];
+  const std::string without_last_term = main.substr(0, main.rfind('\n', main.size() - 2) + 1);
+
+  ASSERT_THROW(parse_main_text(""), std::runtime_error);                                            // No header.
+  ASSERT_THROW(parse_main_text(without_last_term), std::runtime_error);                             // Fewer terms than declared.
+  ASSERT_THROW(parse_main_text(std::string { main }.replace(main.find("22639"), 1, "x")), std::runtime_error);    // Invalid number.
+  ASSERT_THROW(parse_main_text(std::string { main }.replace(main.find("  2  0 -1"), 3, "999")), std::runtime_error); // Not an int8.
+  ASSERT_THROW(parse_perturbation_text(perturbation.substr(perturbation.find('\n') + 1)), std::runtime_error); // A term as a header.
+
+  // The blocks must be in the order of the powers.
+  std::string swapped = perturbation;
+  swapped.replace(swapped.find("         1\n"), 11, "         2\n");
+  ASSERT_THROW(parse_perturbation_text(swapped), std::runtime_error);
+}
+
+TEST(Elpmpp02, Binary) {
+  const auto coefficients = parse_files(write_files());
+
+  std::stringstream binary;
+  write_binary(binary, coefficients);
+  const std::string bytes = binary.str();
+  ASSERT_EQ(bytes.size(), 8U + 4U + 3U * 4U + 181U * 52U + 12U * 4U + PERTURBATIONS.size() * 29U);
+
+  const auto read = [](const std::string& bytes) {
+    std::istringstream in { bytes };
+    return read_binary(in);
+  };
+  const auto loaded = read(bytes);
+  for (std::size_t variable = 0; variable < VARIABLES; ++variable) {
+    ASSERT_EQ(loaded.main.at(variable).size(), coefficients.main.at(variable).size());
+    for (std::size_t i = 0; i < loaded.main.at(variable).size(); ++i) {
+      const MainTerm& lhs = loaded.main.at(variable).at(i);
+      const MainTerm& rhs = coefficients.main.at(variable).at(i);
+      ASSERT_EQ(lhs.multipliers, rhs.multipliers);
+      ASSERT_EQ(lhs.A, rhs.A);
+      ASSERT_EQ(lhs.B, rhs.B);
+    }
+    for (std::size_t power = 0; power < POWERS; ++power) {
+      const auto& lhs = loaded.perturbation.at(variable).at(power);
+      const auto& rhs = coefficients.perturbation.at(variable).at(power);
+      ASSERT_EQ(lhs.size(), rhs.size());
+      for (std::size_t i = 0; i < lhs.size(); ++i) {
+        ASSERT_EQ(lhs[i].multipliers, rhs[i].multipliers);
+        ASSERT_EQ(lhs[i].S, rhs[i].S);
+        ASSERT_EQ(lhs[i].C, rhs[i].C);
+      }
+    }
+  }
+
+  ASSERT_THROW(read(""), std::runtime_error);                                 // Empty.
+  ASSERT_THROW(read("ELPMPP01" + bytes.substr(8)), std::runtime_error);       // Another magic.
+  ASSERT_THROW(read(bytes.substr(0, bytes.size() - 1)), std::runtime_error);  // Truncated.
+  ASSERT_THROW(read(bytes + '\0'), std::runtime_error);                       // Trailing bytes.
+  std::string version = bytes;
+  version[8] = 2;
+  ASSERT_THROW(read(version), std::runtime_error);                            // Another version.
+}
+
+TEST(Elpmpp02, Series) {
+  const Series series { parse_files(write_files()) };
+  ASSERT_EQ(series.term_count(), 60U + 60U + 61U + PERTURBATIONS.size());
+
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jc = util::random(-2.0, 2.0);
+
+    // The truncation of Meeus, as ELP/MPP02, agrees with `elp2000_82b::evaluate`, up to:
+    // - The correction of the eccentricity of the EMB, E, which ELP/MPP02 has in its perturbations instead.
+    // - The light-time, which Meeus includes in L'.
+    // - The fundamental arguments, which Meeus rounds.
+    const auto expected = astro::elp2000_82b::evaluate(jc);
+    const auto coord = precess_from_j2000(to_j2000(series.evaluate(jc), jc), jc);
+    const double λ = expected.ctx.Lp.deg() + expected.Σl / 1e6;
+    ASSERT_NEAR(std::remainder(coord.λ * 180.0 / std::numbers::pi - λ, 360.0), 0.0, 0.003) << jc;
+    ASSERT_NEAR(coord.β * 180.0 / std::numbers::pi, expected.Σb / 1e6, 0.001) << jc;
+    ASSERT_NEAR(coord.r, 385000.56 + expected.Σr / 1e3, 5.0) << jc;
+
+    // The threshold skips the smaller terms, and never more than their sum.
+    std::size_t last_count = series.term_count(jc, 0.0);
+    ASSERT_EQ(last_count, series.term_count());
+    const auto full = series.evaluate(jc);
+    for (const double threshold : { 1.0, 10.0, 100.0, 1000.0, 1e6 }) {
+      const std::size_t count = series.term_count(jc, threshold);
+      ASSERT_LE(count, last_count);
+      last_count = count;
+
+      const auto truncated = series.evaluate(jc, threshold);
+      const double bound = static_cast<double>(series.term_count() - count) * threshold / 206264.8;
+      ASSERT_NEAR(truncated.V, full.V, bound + 1e-12);
+      ASSERT_NEAR(truncated.U, full.U, bound + 1e-12);
+      ASSERT_NEAR(truncated.r / MEAN_DISTANCE, full.r / MEAN_DISTANCE, bound + 1e-12);
+    }
+    ASSERT_EQ(last_count, 0U);
+  }
+
+  // At J2000, the terms of t^1 to t^3 vanish, and are skipped with any threshold.
+  ASSERT_EQ(series.term_count(0.0, 1e-9), series.term_count(1.0, 1e-9) - 1);
+}
+
+TEST(Elpmpp02, Registry) {
+  using astro::moon::geocentric_coord::apparent;
+  using astro::moon::geocentric_coord::apparent_elpmpp02;
+
+  ASSERT_FALSE(is_loaded());
+  ASSERT_THROW(apparent_elpmpp02(julian_day::J2000), std::runtime_error);
+  ASSERT_THROW(load("/nonexistent/elpmpp02.bin"), std::runtime_error);
+  ASSERT_FALSE(is_loaded());
+
+  const auto path = std::filesystem::temp_directory_path() / "elpmpp02_test.bin";
+  {
+    std::ofstream out { path, std::ios::binary };
+    write_binary(out, parse_files(write_files()));
+  }
+  load(path);
+  std::filesystem::remove(path);
+  ASSERT_TRUE(is_loaded());
+  ASSERT_THROW(load(path), std::runtime_error);
+
+  // The apparent position agrees with the truncation of Meeus, which also has its perturbations and E.
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jde = julian_day::J2000 + util::random(-36525.0, 36525.0);
+    const auto expected = apparent(jde);
+    const auto coord = apparent_elpmpp02(jde);
+    ASSERT_NEAR(std::remainder(coord.λ.deg() - expected.λ.deg(), 360.0), 0.0, 0.01);
+    ASSERT_NEAR(coord.β.deg(), expected.β.deg(), 0.01);
+    ASSERT_NEAR(coord.r.km(), expected.r.km(), 2.0);
+    ASSERT_TRUE(coord.λ.deg() >= 0.0 and coord.λ.deg() < 360.0);
+  }
+}
+
+} // namespace astro::elpmpp02::test
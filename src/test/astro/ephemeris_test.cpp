@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include "random.hpp"
+#include "sun.hpp"
+#include "ephemeris.hpp"
+
+namespace astro::ephemeris::test {
+
+using namespace astro::ephemeris;
+
+/** @brief Return a path in the temp directory, which is removed at the end of the scope. */
+struct TempPath {
+  std::string path;
+
+  explicit TempPath(const std::string& name) 
+    : path { (std::filesystem::temp_directory_path() / name).string() } {}
+
+  ~TempPath() {
+    std::filesystem::remove(path);
+  }
+
+  TempPath(const TempPath&) = delete;
+  TempPath(TempPath&&) = delete;
+  auto operator=(const TempPath&) -> TempPath& = delete;
+  auto operator=(TempPath&&) -> TempPath& = delete;
+};
+
+
+TEST(Ephemeris, Chebyshev) {
+  // Interpolate exp(x) on [-1, 1].
+  constexpr std::size_t n = 16;
+  std::vector<double> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = std::exp(chebyshev_node(i, n));
+  }
+  const auto coeffs = chebyshev_fit(values, n);
+  ASSERT_EQ(coeffs.size(), n);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const double x = util::random(-1.0, 1.0);
+    ASSERT_NEAR(clenshaw(coeffs, x), std::exp(x), 1e-14);
+  }
+
+  // The leading coefficients of a polynomial are recovered exactly. 2x^2 - 1 is T_2.
+  for (std::size_t i = 0; i < 4; ++i) {
+    const double x = chebyshev_node(i, 4);
+    values[i] = 2.0 * x * x - 1.0;
+  }
+  const auto t2 = chebyshev_fit(std::span { values }.first(4), 3);
+  ASSERT_NEAR(t2[0], 0.0, 1e-15);
+  ASSERT_NEAR(t2[1], 0.0, 1e-15);
+  ASSERT_NEAR(t2[2], 1.0, 1e-15);
+
+  ASSERT_EQ(clenshaw({}, 0.5), 0.0);
+}
+
+
+TEST(Ephemeris, GenerateAndLookup) {
+  const TempPath file { "celestial_calendar_ephemeris_test.bin" };
+
+  const double start_jde = astro::julian_day::J2000 + util::random(-36525.0, 36525.0);
+  const double end_jde = start_jde + 1000.0;
+  astro::sun::geocentric_coord::generate_ephemeris(file.path, start_jde, end_jde);
+
+  const Ephemeris ephemeris { file.path };
+  const auto& header = ephemeris.header();
+  ASSERT_EQ(header.magic, MAGIC);
+  ASSERT_EQ(header.version, VERSION);
+  ASSERT_EQ(header.granule_count, 32U); // ceil(1000 / 32)
+  ASSERT_EQ(ephemeris.start_jde(), start_jde);
+  ASSERT_GE(ephemeris.end_jde(), end_jde);
+  ASSERT_EQ(std::filesystem::file_size(file.path), sizeof(Header) + 32 * (28 + 20 + 20) * sizeof(double));
+
+  for (std::size_t i = 0; i < 500; ++i) {
+    const double jde = util::random(start_jde, end_jde);
+    ASSERT_TRUE(ephemeris.covers(jde));
+
+    const auto looked_up = ephemeris.lookup(jde);
+    const auto expected = astro::sun::geocentric_coord::apparent(jde);
+
+    const double Δλ = std::abs(looked_up.λ.deg() - expected.λ.deg());
+    ASSERT_LE(std::min(Δλ, 360.0 - Δλ), 1e-8);
+    ASSERT_NEAR(looked_up.β.deg(), expected.β.deg(), 1e-8);
+    ASSERT_NEAR(looked_up.r.au(), expected.r.au(), 1e-10);
+    ASSERT_GE(looked_up.λ.deg(), 0.0);
+    ASSERT_LT(looked_up.λ.deg(), 360.0);
+  }
+
+  // Out of the coverage.
+  ASSERT_FALSE(ephemeris.covers(start_jde - 1e-6));
+  ASSERT_FALSE(ephemeris.covers(ephemeris.end_jde()));
+  ASSERT_THROW(std::ignore = ephemeris.lookup(start_jde - 1.0), std::out_of_range);
+  ASSERT_THROW(std::ignore = ephemeris.lookup(ephemeris.end_jde() + 1.0), std::out_of_range);
+
+  // Invalid arguments.
+  ASSERT_THROW(astro::sun::geocentric_coord::generate_ephemeris(file.path, end_jde, start_jde), std::invalid_argument);
+  ASSERT_THROW(astro::sun::geocentric_coord::generate_ephemeris(file.path, start_jde, end_jde, { .granule_days = 0.0 }), std::invalid_argument);
+  ASSERT_THROW(astro::sun::geocentric_coord::generate_ephemeris(file.path, start_jde, end_jde, { .counts = { 28, 0, 20 } }), std::invalid_argument);
+}
+
+
+TEST(Ephemeris, InvalidFiles) {
+  const TempPath file { "celestial_calendar_ephemeris_invalid_test.bin" };
+  astro::sun::geocentric_coord::generate_ephemeris(file.path, astro::julian_day::J2000, astro::julian_day::J2000 + 64.0);
+
+  std::vector<char> content;
+  {
+    std::ifstream in { file.path, std::ios::binary };
+    content.assign(std::istreambuf_iterator<char> { in }, std::istreambuf_iterator<char> {});
+  }
+  ASSERT_NO_THROW(Ephemeris { file.path });
+
+  const auto write = [&](const std::vector<char>& bytes) {
+    std::ofstream out { file.path, std::ios::binary | std::ios::trunc };
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  };
+
+  // Corrupted payload.
+  auto corrupted = content;
+  corrupted.back() ^= 0x01;
+  write(corrupted);
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+
+  // Unsupported version.
+  auto versioned = content;
+  versioned[offsetof(Header, version)] += 1;
+  write(versioned);
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+
+  // Wrong magic.
+  auto magic = content;
+  magic[0] = 'X';
+  write(magic);
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+
+  // Truncated.
+  write({ content.begin(), content.end() - 8 });
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+  write({ content.begin(), content.begin() + 10 });
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+
+  // A granule count which wraps `granule_count * stride * sizeof(double)` around to the size of an empty payload.
+  Header wrapped {};
+  std::memcpy(&wrapped, content.data(), sizeof(Header));
+  wrapped = to_little_endian(wrapped);
+  wrapped.counts = { 1, 1, 1 };
+  wrapped.granule_count = uint64_t { 1 } << 61U;
+  wrapped.checksum = fnv1a({});
+  wrapped = to_little_endian(wrapped);
+  std::vector<char> header_only(sizeof(Header));
+  std::memcpy(header_only.data(), &wrapped, sizeof(Header));
+  write(header_only);
+  ASSERT_THROW(Ephemeris { file.path }, std::runtime_error);
+
+  // Missing.
+  ASSERT_THROW(Ephemeris { file.path + ".missing" }, std::runtime_error);
+}
+
+}  // namespace astro::ephemeris::test
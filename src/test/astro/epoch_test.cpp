@@ -0,0 +1,114 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "random.hpp"
+#include "julian_day.hpp"
+#include "earth.hpp"
+#include "epoch.hpp"
+#include "sun.hpp"
+#include "moon.hpp"
+#include "moon_phase.hpp"
+#include "sidereal_time.hpp"
+#include "coord_transform.hpp"
+
+
+namespace astro::epoch::test {
+
+using namespace astro::epoch;
+using astro::earth::nutation::Model;
+
+
+TEST(Epoch, MakeContext) {
+  for (const Model model : { Model::MEEUS, Model::IAU_1980, Model::IAU_2000B }) {
+    for (int i = 0; i < 1000; ++i) {
+      const double jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+      const EpochContext ctx = make_context(jde, model);
+
+      ASSERT_EQ(ctx.jde, jde);
+      ASSERT_EQ(ctx.model, model);
+      ASSERT_DOUBLE_EQ(ctx.jc, astro::julian_day::jde_to_jc(jde));
+
+      const auto [Δψ, Δε] = astro::earth::nutation::compute(jde, model);
+      ASSERT_DOUBLE_EQ(ctx.nutation.Δψ.deg(), Δψ.deg());
+      ASSERT_DOUBLE_EQ(ctx.nutation.Δε.deg(), Δε.deg());
+      ASSERT_DOUBLE_EQ(ctx.ε0.deg(), astro::earth::obliquity::mean(jde).deg());
+      ASSERT_DOUBLE_EQ(ctx.ε.deg(), astro::earth::obliquity::true_obliquity(jde, model).deg());
+    }
+  }
+}
+
+
+TEST(Epoch, SharedBySunAndMoon) {
+  for (int i = 0; i < 1000; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-36525.0 * 5, 36525.0 * 5);
+    const EpochContext ctx = make_context(jde);
+
+    const auto sun = astro::sun::geocentric_coord::apparent(jde);
+    const auto sun_ctx = astro::sun::geocentric_coord::apparent(ctx);
+    ASSERT_DOUBLE_EQ(sun_ctx.λ.deg(), sun.λ.deg());
+    ASSERT_DOUBLE_EQ(sun_ctx.β.deg(), sun.β.deg());
+    ASSERT_DOUBLE_EQ(sun_ctx.r.au(), sun.r.au());
+
+    const auto moon = astro::moon::geocentric_coord::apparent(jde);
+    const auto moon_ctx = astro::moon::geocentric_coord::apparent(ctx);
+    ASSERT_DOUBLE_EQ(moon_ctx.λ.deg(), moon.λ.deg());
+    ASSERT_DOUBLE_EQ(moon_ctx.β.deg(), moon.β.deg());
+    ASSERT_DOUBLE_EQ(moon_ctx.r.km(), moon.r.km());
+
+    // The longitude difference is invariant under the nutation, which is shared.
+    const double diff = (moon.λ - sun.λ).normalize().deg();
+    ASSERT_NEAR(astro::moon_phase::new_moon::longitude_diff(jde), diff, 1e-12);
+  }
+}
+
+
+TEST(Epoch, SiderealTimeAndTransforms) {
+  using astro::toolbox::Angle;
+  using astro::toolbox::AngleUnit::DEG;
+
+  for (const Model model : { Model::MEEUS, Model::IAU_1980, Model::IAU_2000B }) {
+    for (int i = 0; i < 1000; ++i) {
+      const double jde = astro::julian_day::J2000 + util::random(-36525.0 * 5, 36525.0 * 5);
+      const double jd_ut1 = jde - util::random(0.0, 0.01);
+      const EpochContext ctx = make_context(jde, model);
+
+      const auto gast = astro::sidereal::greenwich_apparent(jd_ut1, jde, model);
+      ASSERT_DOUBLE_EQ(astro::sidereal::greenwich_apparent(jd_ut1, ctx).deg(), gast.deg());
+
+      const Angle<DEG> longitude { util::random(-180.0, 180.0) };
+      const auto last = astro::sidereal::local_apparent(jd_ut1, jde, longitude, model);
+      ASSERT_DOUBLE_EQ(astro::sidereal::local_apparent(jd_ut1, ctx, longitude).deg(), last.deg());
+
+      const Angle<DEG> λ { util::random(0.0, 360.0) };
+      const Angle<DEG> β { util::random(-90.0, 90.0) };
+      const auto equatorial = astro::coords::ecliptic_to_equatorial(λ, β, astro::earth::obliquity::true_obliquity(jde, model));
+      const auto equatorial_ctx = astro::coords::ecliptic_to_equatorial(λ, β, ctx);
+      ASSERT_DOUBLE_EQ(equatorial_ctx.α.deg(), equatorial.α.deg());
+      ASSERT_DOUBLE_EQ(equatorial_ctx.δ.deg(), equatorial.δ.deg());
+    }
+  }
+}
+
+} // namespace astro::epoch::test
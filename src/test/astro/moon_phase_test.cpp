@@ -82,6 +82,22 @@ TEST(NewMoon, Moments) {
 }
 
 
+TEST(NewMoon, NewtonMethod) {
+  const auto jde = astro::julian_day::J2000 + util::random(-200000.0, 200000.0);
+  const auto [left, right] = first_root_range_after(jde);
+  const double root = newton_method(left, right);
+  ASSERT_LE(left, root);
+  ASSERT_LE(root, right);
+  const double diff = longitude_diff(root);
+  ASSERT_LT(std::min(diff, 360.0 - diff), 1e-6);
+
+  // The longitude difference is ~336° two days before the conjunction, and ~354° half a day before. 
+  // The sign changes only at the fold at 345°, so the range holds no conjunction.
+  ASSERT_THROW(newton_method(root - 2.0, root - 0.5), std::invalid_argument);
+  ASSERT_THROW(newton_method(left, right, 0), std::runtime_error);
+}
+
+
 TEST(NewMoon, DiffTest1) {
   using namespace std::ranges;
   using namespace std::chrono_literals;
@@ -157,4 +173,94 @@ TEST(NewMoon, DiffTest2) {
   }
 }
 
+
+TEST(MoonPhase, MeeusEstimate) {
+  // Examples 49.a and 49.b of Astronomical Algorithms, Jean Meeus, 1998.
+  ASSERT_NEAR(meeus::estimate(-283, Phase::NEW_MOON), 2443192.65118, 1e-5);
+  ASSERT_NEAR(meeus::estimate(544, Phase::LAST_QUARTER), 2467636.49186, 1e-5);
+
+  // The lunation 0 starts on 2000-01-06.
+  ASSERT_EQ(meeus::mean_lunation(meeus::EPOCH), 0);
+  ASSERT_EQ(meeus::mean_lunation(meeus::EPOCH - 1.0), -1);
+  ASSERT_EQ(meeus::mean_lunation(meeus::EPOCH + meeus::SYNODIC_MONTH * 100.5), 100);
+}
+
+
+TEST(MoonPhase, Solve) {
+  for (int i = 0; i < 50; ++i) {
+    // The lunations over the years -2000 to 4000.
+    const auto lunation = static_cast<int64_t>(util::random(-49000.0, 24700.0));
+
+    for (const Phase phase : { Phase::NEW_MOON, Phase::FIRST_QUARTER, Phase::FULL_MOON, Phase::LAST_QUARTER }) {
+      const double jde = solve(lunation, phase);
+      const auto [offset, rate] = elongation_offset(jde, phase);
+      ASSERT_NEAR(offset, 0.0, 1e-8);
+      ASSERT_GT(rate, 10.0);
+
+      // The estimate is within a few minutes.
+      ASSERT_NEAR(jde, meeus::estimate(lunation, phase), 300.0 / 86400.0);
+    }
+  }
+}
+
+
+TEST(MoonPhase, PhaseGenerator) {
+  const auto start_jde = astro::julian_day::J2000 + util::random(-200000.0, 200000.0);
+
+  PhaseGenerator gen(start_jde);
+  auto prev = gen.next();
+  ASSERT_GE(prev.jde, start_jde);
+  ASSERT_NEAR(prev.jde, start_jde, 8.0);
+
+  for (int i = 0; i < 64; ++i) {
+    const auto moment = gen.next();
+
+    // The phases come in order, and a lunation starts at the new moon.
+    ASSERT_EQ(static_cast<uint8_t>(moment.phase), (static_cast<uint8_t>(prev.phase) + 1) % PHASE_COUNT);
+    ASSERT_EQ(moment.lunation, prev.lunation + (moment.phase == Phase::NEW_MOON ? 1 : 0));
+
+    // The quarters are roughly a quarter of a lunar month apart.
+    ASSERT_GT(moment.jde - prev.jde, 6.0);
+    ASSERT_LT(moment.jde - prev.jde, 9.0);
+
+    const auto [offset, _] = elongation_offset(moment.jde, moment.phase);
+    ASSERT_NEAR(offset, 0.0, 1e-8);
+    prev = moment;
+  }
+
+  // Generate a single phase.
+  PhaseGenerator full_moons(start_jde, Phase::FULL_MOON);
+  double prev_jde = start_jde;
+  for (int i = 0; i < 16; ++i) {
+    const auto moment = full_moons.next();
+    ASSERT_EQ(moment.phase, Phase::FULL_MOON);
+    ASSERT_GE(moment.jde, prev_jde);
+    ASSERT_LT(moment.jde - prev_jde, 29.9);
+    prev_jde = moment.jde;
+  }
+}
+
+
+TEST(MoonPhase, Phases) {
+  const int32_t year = util::random(1700, 2050);
+  const auto [start_jde, end_jde] = year_range(year);
+  const auto moments_in_year = phases(year);
+
+  ASSERT_GE(moments_in_year.size(), 48);
+  ASSERT_LE(moments_in_year.size(), 52);
+  for (const auto& moment : moments_in_year) {
+    ASSERT_GE(moment.jde, start_jde);
+    ASSERT_LT(moment.jde, end_jde);
+  }
+
+  // The new moons are the same as `new_moon::moments`.
+  std::vector<double> new_moons;
+  for (const auto& moment : moments_in_year) {
+    if (moment.phase == Phase::NEW_MOON) {
+      new_moons.push_back(moment.jde);
+    }
+  }
+  ASSERT_EQ(new_moons, moments(year));
+}
+
 } // namespace astro::moon_phase::test
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <vector>
 #include <unordered_map>
 #include "util.hpp"
 #include "astro.hpp"
@@ -219,4 +220,85 @@ TEST(Moon, RandomApparentPosition) {
   }
 }
 
+TEST(Moon, ApparentBatch) {
+  // The batch version must agree with `apparent`, for every size of the last (padded) vector.
+  for (const std::size_t count : { 1UZ, 2UZ, 3UZ, 7UZ, 100UZ }) {
+    std::vector<double> jdes(count);
+    for (double& jde : jdes) {
+      jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+    }
+
+    std::vector<double> lons(count), lats(count), rs(count);
+    apparent_batch(jdes, lons, lats, rs);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto coord = apparent(jdes[i]);
+
+      // Within rounding, except at the wrap-around of the longitude.
+      const double Δλ = std::remainder(lons[i] - coord.λ.deg(), 360.0);
+      ASSERT_NEAR(Δλ, 0.0, 1e-9);
+      ASSERT_NEAR(lats[i], coord.β.deg(), 1e-9);
+      ASSERT_NEAR(rs[i], coord.r.km(), 1e-6);
+      ASSERT_TRUE(lons[i] >= 0.0 and lons[i] < 360.0);
+    }
+  }
+
+  // Nothing to do for an empty batch.
+  ASSERT_NO_THROW(apparent_batch({}, {}, {}, {}));
+
+  // The output spans must match the input span.
+  std::vector<double> jdes(4, astro::julian_day::J2000), out(4), short_out(3);
+  ASSERT_THROW(apparent_batch(jdes, out, out, short_out), std::invalid_argument);
+  ASSERT_THROW(apparent_batch(jdes, short_out, out, out), std::invalid_argument);
+}
+
+TEST(Moon, ApparentWithNutationInterpolator) {
+  const double start_jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+  const astro::earth::nutation::NutationInterpolator nutation { start_jde, start_jde + 30.0 };
+
+  // Only the nutation in longitude is interpolated, within 0".001.
+  for (auto i = 0; i < 100; ++i) {
+    const double jde = util::random(start_jde, start_jde + 30.0);
+    const auto coord = apparent(jde, nutation);
+    const auto expected = apparent(jde);
+
+    const double Δλ = std::remainder(coord.λ.deg() - expected.λ.deg(), 360.0);
+    ASSERT_NEAR(Δλ, 0.0, 0.001 / 3600.0);
+    ASSERT_EQ(coord.β.deg(), expected.β.deg());
+    ASSERT_EQ(coord.r.km(),  expected.r.km());
+  }
+}
+
+TEST(Moon, ApparentWithRate) {
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+    const auto [coord, rate] = apparent_with_rate(jde);
+
+    // The position is the same as `apparent`.
+    const auto expected = apparent(jde);
+    ASSERT_EQ(coord.λ.deg(), expected.λ.deg());
+    ASSERT_EQ(coord.β.deg(), expected.β.deg());
+    ASSERT_EQ(coord.r.au(),  expected.r.au());
+
+    // The rates agree with the central differences. The Moon moves roughly 12 to 15 degrees per day.
+    // Divide by the actual distance between the JDEs, since `jde ± h` is rounded.
+    const double jde_after = jde + 1e-2;
+    const double jde_before = jde - 1e-2;
+    const double Δt = jde_after - jde_before;
+    const auto after = apparent(jde_after);
+    const auto before = apparent(jde_before);
+    const double Δλ = astro::toolbox::normalize_pm180(after.λ.deg() - before.λ.deg());
+    ASSERT_NEAR(rate.λ, Δλ / Δt, 1e-5);
+    ASSERT_NEAR(rate.β, (after.β.deg() - before.β.deg()) / Δt, 1e-5);
+    ASSERT_NEAR(rate.r, (after.r.au() - before.r.au()) / Δt, 1e-10);
+    ASSERT_GT(rate.λ, 11.0);
+    ASSERT_LT(rate.λ, 16.0);
+
+    // The nutation can be passed in, e.g. to share it between the Sun and the Moon.
+    const auto shared = apparent_with_rate(jde, astro::earth::nutation::compute_with_rate(jde));
+    ASSERT_EQ(shared.coord.λ.deg(), coord.λ.deg());
+    ASSERT_EQ(shared.rate.λ, rate.λ);
+  }
+}
+
 } // namespace astro::moon::test
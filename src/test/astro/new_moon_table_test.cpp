@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include "random.hpp"
+#include "moon_phase.hpp"
+#include "new_moon_table.hpp"
+
+namespace astro::new_moon_table::test {
+
+using namespace astro::new_moon_table;
+namespace new_moon = astro::moon_phase::new_moon;
+
+/** @brief Return a path in the temp directory, which is removed at the end of the scope. */
+struct TempPath {
+  std::string path;
+
+  explicit TempPath(const std::string& name) 
+    : path { (std::filesystem::temp_directory_path() / name).string() } {}
+
+  ~TempPath() {
+    std::filesystem::remove(path);
+  }
+
+  TempPath(const TempPath&) = delete;
+  TempPath(TempPath&&) = delete;
+  auto operator=(const TempPath&) -> TempPath& = delete;
+  auto operator=(TempPath&&) -> TempPath& = delete;
+};
+
+
+TEST(NewMoonTable, GenerateAndLookup) {
+  const TempPath file { "celestial_calendar_new_moon_table_test.bin" };
+
+  const double start_jde = astro::julian_day::J2000 + util::random(-365250.0, 365250.0);
+  const double end_jde = start_jde + 3650.0;
+  new_moon::generate_table(file.path, start_jde, end_jde);
+
+  const Table table { file.path };
+  const auto& header = table.header();
+  ASSERT_EQ(header.magic, MAGIC);
+  ASSERT_EQ(header.version, VERSION);
+  ASSERT_EQ(header.unit, UNIT);
+  ASSERT_EQ(std::filesystem::file_size(file.path), sizeof(Header) + header.count * sizeof(int32_t));
+  ASSERT_TRUE(table.covers(start_jde));
+  ASSERT_TRUE(table.covers(end_jde));
+
+  // Every new moon is the solved one, to the fixed-point unit.
+  for (int64_t lunation = table.first_lunation(); lunation <= table.last_lunation(); ++lunation) {
+    const double solved = astro::moon_phase::solve(lunation, astro::moon_phase::Phase::NEW_MOON);
+    ASSERT_NEAR(table.lookup(lunation), solved, UNIT);
+  }
+  ASSERT_FALSE(table.contains(table.first_lunation() - 1));
+  ASSERT_FALSE(table.contains(table.last_lunation() + 1));
+  ASSERT_THROW(std::ignore = table.lookup(table.last_lunation() + 1), std::out_of_range);
+
+  // The first new moon at or after a JDE.
+  for (std::size_t i = 0; i < 100; ++i) {
+    const double jde = util::random(start_jde, end_jde);
+    const int64_t lunation = table.first_at_or_after(jde);
+    ASSERT_GE(table.lookup(lunation), jde);
+    ASSERT_LT(table.lookup(lunation - 1), jde);
+  }
+  ASSERT_EQ(table.first_at_or_after(table.lookup(table.first_lunation() + 3)), table.first_lunation() + 3);
+  ASSERT_THROW(std::ignore = table.first_at_or_after(start_jde - 100.0), std::out_of_range);
+
+  // Verify the table against the live ephemeris.
+  const auto verification = new_moon::verify_table(table, 7);
+  ASSERT_GT(verification.count, 1U);
+  ASSERT_LE(verification.max_diff, UNIT);
+  ASSERT_THROW(std::ignore = new_moon::verify_table(table, 0), std::invalid_argument);
+
+  // Invalid range.
+  ASSERT_THROW(new_moon::generate_table(file.path, end_jde, start_jde), std::invalid_argument);
+}
+
+
+TEST(NewMoonTable, RootGenerator) {
+  const TempPath file { "celestial_calendar_new_moon_table_generator_test.bin" };
+
+  const int32_t year = util::random(1700, 2050);
+  const auto [start_jde, end_jde] = astro::moon_phase::year_range(year);
+  const auto solved = new_moon::moments(year);
+
+  new_moon::generate_table(file.path, start_jde, end_jde);
+  new_moon::use_table(file.path);
+  ASSERT_NE(new_moon::active_table(), nullptr);
+
+  // The moments are looked up in the table.
+  const auto looked_up = new_moon::moments(year);
+  ASSERT_EQ(looked_up.size(), solved.size());
+  for (std::size_t i = 0; i < solved.size(); ++i) {
+    ASSERT_NEAR(looked_up[i], solved[i], UNIT);
+  }
+
+  // Beyond the table, the roots are solved.
+  new_moon::RootGenerator gen { end_jde - 40.0 };
+  double prev = gen.next();
+  for (int i = 0; i < 4; ++i) {
+    const double root = gen.next();
+    ASSERT_NEAR(root - prev, 29.5, 0.75);
+    const double diff = new_moon::longitude_diff(root);
+    ASSERT_TRUE(diff < 1e-5 or diff > 360.0 - 1e-5);
+    prev = root;
+  }
+
+  // An invalid file keeps the table in use.
+  ASSERT_THROW(new_moon::use_table(file.path + ".missing"), std::runtime_error);
+  ASSERT_NE(new_moon::active_table(), nullptr);
+
+  new_moon::clear_table();
+  ASSERT_EQ(new_moon::active_table(), nullptr);
+  ASSERT_EQ(new_moon::moments(year), solved);
+}
+
+
+TEST(NewMoonTable, InvalidFiles) {
+  const TempPath file { "celestial_calendar_new_moon_table_invalid_test.bin" };
+  new_moon::generate_table(file.path, astro::julian_day::J2000, astro::julian_day::J2000 + 100.0);
+
+  std::vector<char> content;
+  {
+    std::ifstream in { file.path, std::ios::binary };
+    content.assign(std::istreambuf_iterator<char> { in }, std::istreambuf_iterator<char> {});
+  }
+  ASSERT_NO_THROW(Table { file.path });
+
+  const auto write = [&](const std::vector<char>& bytes) {
+    std::ofstream out { file.path, std::ios::binary | std::ios::trunc };
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  };
+
+  // Corrupted payload.
+  auto corrupted = content;
+  corrupted.back() ^= 0x01;
+  write(corrupted);
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+
+  // Unsupported version.
+  auto versioned = content;
+  versioned[offsetof(Header, version)] += 1;
+  write(versioned);
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+
+  // Wrong magic.
+  auto magic = content;
+  magic[0] = 'X';
+  write(magic);
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+
+  // Truncated.
+  write({ content.begin(), content.end() - 4 });
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+  write({ content.begin(), content.begin() + 10 });
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+
+  // A count which wraps `count * sizeof(int32_t)` around to the size of an empty payload.
+  Header wrapped {};
+  std::memcpy(&wrapped, content.data(), sizeof(Header));
+  wrapped = to_little_endian(wrapped);
+  wrapped.count = uint64_t { 1 } << 62U;
+  wrapped.checksum = fnv1a({});
+  wrapped = to_little_endian(wrapped);
+  std::vector<char> header_only(sizeof(Header));
+  std::memcpy(header_only.data(), &wrapped, sizeof(Header));
+  write(header_only);
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+
+  // Missing.
+  std::filesystem::remove(file.path);
+  ASSERT_THROW(Table { file.path }, std::runtime_error);
+}
+
+} // namespace astro::new_moon_table::test
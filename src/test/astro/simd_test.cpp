@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "random.hpp"
+#include "simd.hpp"
+
+namespace astro::simd::test {
+
+using namespace astro::simd;
+
+constexpr double ULP = std::numeric_limits<double>::epsilon();
+
+TEST(Simd, Padded) {
+  ASSERT_EQ(padded(0), 0U);
+  ASSERT_EQ(padded(1), LANES);
+  ASSERT_EQ(padded(LANES), LANES);
+  ASSERT_EQ(padded(LANES + 1), 2 * LANES);
+  ASSERT_EQ(padded(559) % LANES, 0U);
+}
+
+TEST(Simd, CosSin) {
+  // Small arguments, and the large arguments seen in VSOP87D (|C·jm| up to ~3e6 radians over ±10 millennia).
+  for (const double bound : { 10.0, 1e3, 4e6 }) {
+    for (int i = 0; i < 10000; i++) {
+      const double x = util::random(-bound, bound);
+      ASSERT_NEAR(simd::cos(x), std::cos(x), TRIG_ULP_BOUND * ULP) << "x = " << x;
+      ASSERT_NEAR(simd::sin(x), std::sin(x), TRIG_ULP_BOUND * ULP) << "x = " << x;
+
+      const auto [s, c] = simd::sincos(x);
+      ASSERT_EQ(s, simd::sin(x));
+      ASSERT_EQ(c, simd::cos(x));
+    }
+  }
+
+  // Exact values.
+  ASSERT_EQ(simd::cos(0.0), 1.0);
+  ASSERT_EQ(simd::sin(0.0), 0.0);
+}
+
+TEST(Simd, VectorLanes) {
+  // The vector kernels must give exactly the same results as the scalar kernels, lane by lane.
+  std::array<double, LANES> xs {};
+  for (int i = 0; i < 1000; i++) {
+    for (auto& x : xs) {
+      x = util::random(-1e6, 1e6);
+    }
+
+    const VecD v = load(xs, 0);
+    const VecD c = simd::cos(v);
+    const VecD s = simd::sin(v);
+
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+      ASSERT_EQ(c[lane], simd::cos(xs[lane]));
+      ASSERT_EQ(s[lane], simd::sin(xs[lane]));
+    }
+  }
+}
+
+TEST(Simd, Accumulate) {
+  std::array<double, LANES> xs {};
+  for (std::size_t i = 0; i < LANES; ++i) {
+    xs[i] = util::random(-1e3, 1e3);
+  }
+
+  // Same rounding as a sequential loop.
+  double expected = 1e10;
+  for (const double x : xs) {
+    expected += x;
+  }
+
+  ASSERT_EQ(accumulate(load(xs, 0), 1e10), expected);
+}
+
+TEST(Simd, CosNarrow) {
+  std::array<double, FLOAT_LANES> xs {};
+  for (const double bound : { 10.0, 1e3, 4e6 }) {
+    for (int i = 0; i < 1000; i++) {
+      for (auto& x : xs) {
+        x = util::random(-bound, bound);
+      }
+
+      // Lane i is of `lo[i]`, and lane `LANES + i` is of `hi[i]`.
+      const VecF c = cos_narrow(load(xs, 0), load(xs, LANES));
+      for (std::size_t lane = 0; lane < FLOAT_LANES; ++lane) {
+        ASSERT_NEAR(c[lane], std::cos(xs[lane]), NARROW_COS_BOUND) << "x = " << xs[lane];
+      }
+    }
+  }
+
+  // The lanes are narrowed in order.
+  const VecF v = narrow(splat(1.0), splat(2.0));
+  for (std::size_t lane = 0; lane < FLOAT_LANES; ++lane) {
+    ASSERT_EQ(v[lane], lane < LANES ? 1.0F : 2.0F);
+  }
+}
+
+} // namespace astro::simd::test
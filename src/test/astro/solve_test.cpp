@@ -0,0 +1,148 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "random.hpp"
+#include "solve.hpp"
+
+
+namespace astro::solve::test {
+
+using namespace astro::solve;
+
+// The unknowns are in days, and the tolerances in seconds. 
+// A tolerance of 1e-4 seconds is ~1.16e-9 days.
+constexpr double TOLERANCE = 1e-4;
+constexpr double TOLERANCE_DAYS = TOLERANCE / SECONDS_PER_DAY;
+
+
+TEST(Solve, Newton) {
+  // cos(x) = x, with the root 0.7390851332151607.
+  const auto f = [](const double x) -> Sample {
+    return { .value = std::cos(x) - x, .derivative = -std::sin(x) - 1.0 };
+  };
+
+  const Result result = newton(f, 1.0, { .tolerance = TOLERANCE });
+  ASSERT_TRUE(result.converged);
+  ASSERT_NEAR(result.root, 0.7390851332151607, 1e-15);
+  ASSERT_EQ(result.iterations, result.evaluations);
+  ASSERT_LE(result.iterations, 6U);
+  ASSERT_LT(std::fabs(result.last_step), TOLERANCE_DAYS);
+
+  // The iterates are clamped into the interval. The root beyond it does not converge.
+  const Result clamped = newton(f, 0.0, { .tolerance = TOLERANCE }, { .lower = 0.0, .upper = 0.5 });
+  ASSERT_FALSE(clamped.converged);
+  ASSERT_EQ(clamped.root, 0.5);
+  ASSERT_EQ(clamped.iterations, 30U);
+
+  // A vanishing derivative stops the iteration.
+  const Result flat = newton([](const double) { return Sample { .value = 1.0, .derivative = 0.0 }; }, 0.0);
+  ASSERT_FALSE(flat.converged);
+  ASSERT_EQ(flat.iterations, 1U);
+}
+
+
+TEST(Solve, Halley) {
+  // x³ = a, from far away.
+  for (int i = 0; i < 100; ++i) {
+    const double a = util::random(1.0, 1e6);
+    const auto f = [a](const double x) -> Sample {
+      return { .value = x * x * x - a, .derivative = 3.0 * x * x, .second_derivative = 6.0 * x };
+    };
+
+    const Result by_halley = halley(f, 100.0, { .tolerance = TOLERANCE });
+    const Result by_newton = newton(f, 100.0, { .tolerance = TOLERANCE });
+    ASSERT_TRUE(by_halley.converged);
+    ASSERT_TRUE(by_newton.converged);
+    ASSERT_NEAR(by_halley.root, std::cbrt(a), 1e-12 * std::cbrt(a));
+    ASSERT_NEAR(by_newton.root, std::cbrt(a), 1e-12 * std::cbrt(a));
+    ASSERT_LE(by_halley.iterations, by_newton.iterations);
+  }
+
+  // Without the second derivative, the steps are Newton's.
+  const auto f = [](const double x) -> Sample {
+    return { .value = std::cos(x) - x, .derivative = -std::sin(x) - 1.0 };
+  };
+  const Result by_halley = halley(f, 1.0);
+  const Result by_newton = newton(f, 1.0);
+  ASSERT_EQ(by_halley.root, by_newton.root);
+  ASSERT_EQ(by_halley.iterations, by_newton.iterations);
+}
+
+
+TEST(Solve, Illinois) {
+  for (int i = 0; i < 100; ++i) {
+    // A root of a monotonic function, with a strongly curved side where the plain false position stalls.
+    const double root = util::random(-10.0, 10.0);
+    const auto f = [root](const double x) { return std::exp(x - root) - 1.0; };
+
+    const Result result = illinois(f, -20.0, 20.0, { .tolerance = TOLERANCE, .max_iterations = 200 });
+    ASSERT_TRUE(result.converged);
+    ASSERT_NEAR(result.root, root, TOLERANCE_DAYS);
+    ASSERT_EQ(result.evaluations, result.iterations + 2);
+  }
+
+  // The derivatives of a `Sample` are not needed.
+  const auto g = [](const double x) { return Sample { .value = x * x - 2.0 }; };
+  ASSERT_NEAR(illinois(g, 0.0, 2.0, { .tolerance = TOLERANCE }).root, std::sqrt(2.0), TOLERANCE_DAYS);
+
+  // An end at the root.
+  ASSERT_EQ(illinois([](const double x) { return x - 1.5; }, 1.5, 2.0).root, 1.5);
+
+  // No sign change.
+  ASSERT_THROW(illinois(g, 2.0, 3.0), std::invalid_argument);
+}
+
+
+TEST(Solve, BracketedNewton) {
+  // atan(x - root): Newton's method alone diverges from more than ~1.39 away from the root.
+  for (int i = 0; i < 100; ++i) {
+    const double root = util::random(-50.0, 50.0);
+    const auto f = [root](const double x) -> Sample {
+      return { .value = std::atan(x - root), .derivative = 1.0 / (1.0 + (x - root) * (x - root)) };
+    };
+
+    const Result result = bracketed_newton(f, -100.0, 100.0, { .tolerance = TOLERANCE });
+    ASSERT_TRUE(result.converged);
+    ASSERT_NEAR(result.root, root, 1e-12);
+    ASSERT_EQ(result.evaluations, result.iterations + 2);
+
+    const Result unguarded = newton(f, root + 2.0);
+    ASSERT_FALSE(unguarded.converged);
+
+    // The values at the ends can be given, and are not evaluated again.
+    const Result given = bracketed_newton(f, -100.0, 100.0, f(-100.0).value, f(100.0).value, { .tolerance = TOLERANCE });
+    ASSERT_EQ(given.root, result.root);
+    ASSERT_EQ(given.evaluations, result.evaluations - 2);
+  }
+
+  // No sign change.
+  const auto g = [](const double x) { return Sample { .value = x * x + 1.0, .derivative = 2.0 * x }; };
+  ASSERT_THROW(bracketed_newton(g, -1.0, 1.0), std::invalid_argument);
+}
+
+} // namespace astro::solve::test
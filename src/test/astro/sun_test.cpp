@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <filesystem>
 #include "util.hpp"
 #include "astro.hpp"
 
@@ -747,6 +748,195 @@ TEST(Sun, RandomApparentPosition) {
   }
 }
 
+TEST(Sun, ApparentBatch) {
+  std::vector<double> jdes(600);
+  for (auto& jde : jdes) {
+    jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+  }
+
+  const auto vsop_coords = vsop87d_batch(jdes);
+  const auto coords = apparent_batch(jdes);
+  ASSERT_EQ(vsop_coords.size(), jdes.size());
+  ASSERT_EQ(coords.size(), jdes.size());
+
+  for (std::size_t i = 0; i < jdes.size(); ++i) {
+    const auto vsop_coord = vsop87d(jdes[i]);
+    ASSERT_DOUBLE_EQ(vsop_coords[i].λ.deg(), vsop_coord.λ.deg());
+    ASSERT_DOUBLE_EQ(vsop_coords[i].β.deg(), vsop_coord.β.deg());
+    ASSERT_DOUBLE_EQ(vsop_coords[i].r.au(),  vsop_coord.r.au());
+
+    const auto coord = apparent(jdes[i]);
+    ASSERT_DOUBLE_EQ(coords[i].λ.deg(), coord.λ.deg());
+    ASSERT_DOUBLE_EQ(coords[i].β.deg(), coord.β.deg());
+    ASSERT_DOUBLE_EQ(coords[i].r.au(),  coord.r.au());
+  }
+}
+
+
+TEST(Sun, ApparentGrid) {
+  // One day, one JDE per minute.
+  const double start_jde = astro::julian_day::J2000 + util::random(-365250.0, 365250.0);
+  const double step = 1.0 / 1440.0;
+  const std::size_t count = 1440;
+
+  const auto coords = apparent_grid(start_jde, step, count);
+  ASSERT_EQ(coords.size(), count);
+
+  // The error budget is 1e-11 radians by default.
+  constexpr double ε = 1e-9; // In degrees.
+  for (std::size_t i = 0; i < count; ++i) {
+    const double jde = start_jde + static_cast<double>(i) * step;
+    const auto coord = apparent(jde);
+
+    const double Δλ = std::abs(coords[i].λ.deg() - coord.λ.deg());
+    ASSERT_LE(std::min(Δλ, 360.0 - Δλ), ε);
+    ASSERT_NEAR(coords[i].β.deg(), coord.β.deg(), ε);
+    ASSERT_NEAR(coords[i].r.au(),  coord.r.au(),  1e-11);
+  }
+}
+
+
+TEST(Sun, ApparentWithNutationInterpolator) {
+  const double start_jde = astro::julian_day::J2000 + util::random(-365250.0 * 5, 365250.0 * 5);
+  const astro::earth::nutation::NutationInterpolator nutation { start_jde, start_jde + 30.0 };
+
+  // Only the nutation in longitude is interpolated, within 0".001.
+  for (auto i = 0; i < 100; ++i) {
+    const double jde = util::random(start_jde, start_jde + 30.0);
+    const auto coord = apparent(jde, nutation);
+    const auto expected = apparent(jde);
+
+    const double Δλ = std::abs(coord.λ.deg() - expected.λ.deg());
+    ASSERT_LE(std::min(Δλ, 360.0 - Δλ), 0.001 / 3600.0);
+    ASSERT_EQ(coord.β.deg(), expected.β.deg());
+    ASSERT_EQ(coord.r.au(),  expected.r.au());
+  }
+}
+
+
+TEST(Sun, PrecisionTiers) {
+  using namespace astro::sun::geocentric_coord::math;
+  using astro::vsop87d::Precision;
+
+  // The apparent longitudes are within the tiers' tolerances.
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-365250.0, 365250.0);
+    const double lon = solar_longitude(jde);
+    for (const auto& [truncated, tolerance] : {
+      std::pair { solar_longitude<Precision::ARCSEC>(jde),     1.0 / 3600.0 },
+      std::pair { solar_longitude<Precision::TEN_ARCSEC>(jde), 10.0 / 3600.0 },
+      std::pair { solar_longitude<Precision::ARCMIN>(jde),     1.0 / 60.0 },
+    }) {
+      const double Δ = std::abs(truncated - lon);
+      ASSERT_LE(std::min(Δ, 360.0 - Δ), tolerance);
+    }
+  }
+
+  // Away from the longitudes at the start and the end of the year, the cheap tiers count the roots correctly.
+  for (int32_t year = 1900; year < 2100; year += 7) {
+    const double start_lon = get_start_lon(year);
+    const double end_lon = get_end_lon(year);
+    for (std::size_t i = 0; i < 10; ++i) {
+      const double lon = util::random(0.0, 360.0);
+      if (std::abs(lon - start_lon) < 1.0 / 60.0 or std::abs(lon - end_lon) < 1.0 / 60.0) {
+        continue;
+      }
+      ASSERT_EQ(discriminant<Precision::ARCMIN>(year, lon), discriminant(year, lon));
+    }
+  }
+}
+
+
+TEST(Sun, Ephemeris) {
+  const std::string path = (std::filesystem::temp_directory_path() / "celestial_calendar_sun_ephemeris_test.bin").string();
+
+  const int32_t year = 2024;
+  const double start_jde = get_start_jde(year) - 40.0;
+  const double end_jde = get_end_jde(year) + 40.0;
+
+  // The roots found with the analytic model.
+  std::vector<std::vector<double>> expected_roots;
+  for (double lon = 0.0; lon < 360.0; lon += 15.0) {
+    expected_roots.emplace_back(find_roots(year, lon));
+  }
+
+  generate_ephemeris(path, start_jde, end_jde);
+  ASSERT_EQ(active_ephemeris(), nullptr);
+  use_ephemeris(path);
+  ASSERT_NE(active_ephemeris(), nullptr);
+
+  // Within the coverage, the ephemeris is used.
+  for (std::size_t i = 0; i < 100; ++i) {
+    const double jde = util::random(start_jde, end_jde);
+    const double Δλ = std::abs(solar_longitude(jde) - apparent(jde).λ.deg());
+    ASSERT_LE(std::min(Δλ, 360.0 - Δλ), 1e-8);
+  }
+
+  // Out of the coverage, it falls back to the analytic model.
+  ASSERT_EQ(solar_longitude(start_jde - 1.0), apparent(start_jde - 1.0).λ.deg());
+  const double after_end = active_ephemeris()->end_jde() + 1.0; // The coverage is rounded up to whole granules.
+  ASSERT_EQ(solar_longitude(after_end), apparent(after_end).λ.deg());
+
+  // The root finders use the ephemeris transparently, snapshotted once per year.
+  const YearBounds bounds = year_bounds(year);
+  ASSERT_EQ(bounds.ephemeris, active_ephemeris());
+  std::size_t index = 0;
+  for (double lon = 0.0; lon < 360.0; lon += 15.0, ++index) {
+    const auto roots = find_roots(year, lon);
+    ASSERT_EQ(roots.size(), expected_roots[index].size());
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+      ASSERT_NEAR(roots[i], expected_roots[index][i], 1e-6); // Within 0.1 seconds.
+    }
+  }
+
+  // An invalid file is rejected, and the ephemeris in use is kept.
+  const auto active = active_ephemeris();
+  ASSERT_THROW(use_ephemeris(path + ".missing"), std::runtime_error);
+  ASSERT_EQ(active_ephemeris(), active);
+
+  clear_ephemeris();
+  ASSERT_EQ(active_ephemeris(), nullptr);
+
+  // The snapshot keeps the ephemeris alive, and is still used after it is cleared.
+  ASSERT_NE(bounds.ephemeris, nullptr);
+  ASSERT_NEAR(find_roots(bounds, 90.0)[0], expected_roots[6][0], 1e-6);
+  ASSERT_EQ(year_bounds(year).ephemeris, nullptr);
+  std::filesystem::remove(path);
+}
+
+
+TEST(Sun, ApparentWithRate) {
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-365250.0, 365250.0);
+    const auto [coord, rate] = apparent_with_rate(jde);
+
+    // The position is the same as `apparent`.
+    const auto expected = apparent(jde);
+    ASSERT_EQ(coord.λ.deg(), expected.λ.deg());
+    ASSERT_EQ(coord.β.deg(), expected.β.deg());
+    ASSERT_EQ(coord.r.au(),  expected.r.au());
+
+    // The rates agree with the central differences. The Sun moves roughly 1 degree per day.
+    // Divide by the actual distance between the JDEs, since `jde ± h` is rounded.
+    const double jde_after = jde + 3e-2;
+    const double jde_before = jde - 3e-2;
+    const double Δt = jde_after - jde_before;
+    const auto after = apparent(jde_after);
+    const auto before = apparent(jde_before);
+    const double Δλ = astro::toolbox::normalize_pm180(after.λ.deg() - before.λ.deg());
+    ASSERT_NEAR(rate.λ, Δλ / Δt, 1e-7);
+    ASSERT_NEAR(rate.β, (after.β.deg() - before.β.deg()) / Δt, 1e-7);
+    ASSERT_NEAR(rate.r, (after.r.au() - before.r.au()) / Δt, 1e-10);
+    ASSERT_GT(rate.λ, 0.9);
+    ASSERT_LT(rate.λ, 1.1);
+
+    // The nutation can be passed in, e.g. to share it between the Sun and the Moon.
+    const auto shared = apparent_with_rate(jde, astro::earth::nutation::compute_with_rate(jde));
+    ASSERT_EQ(shared.coord.λ.deg(), coord.λ.deg());
+    ASSERT_EQ(shared.rate.λ, rate.λ);
+  }
+}
+
 
 using hms_type = hh_mm_ss<nanoseconds>;
 
@@ -828,4 +1018,68 @@ TEST(Sun, FindRoots) {
 }
 
 
+TEST(Sun, SeededRoots) {
+  // The low accuracy longitude is within ~0.01° of the apparent longitude near J2000.
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-36525.0 * 2, 36525.0 * 2);
+    const double Δλ = astro::toolbox::normalize_pm180(low_accuracy_longitude(jde) - solar_longitude(jde));
+    ASSERT_LT(std::abs(Δλ), 0.015);
+  }
+
+  for (int32_t year = 1; year <= 6000; year += 41) {
+    const YearBounds bounds = year_bounds(year);
+    ASSERT_EQ(bounds.start_jde, get_start_jde(year));
+    ASSERT_EQ(bounds.end_jde, get_end_jde(year));
+    ASSERT_EQ(bounds.start_lon, astro::toolbox::normalize_deg(low_accuracy_longitude(bounds.start_jde)));
+    ASSERT_EQ(bounds.end_lon, astro::toolbox::normalize_deg(low_accuracy_longitude(bounds.end_jde)));
+
+    for (double lon = 0.0; lon < 360.0; lon += 15.0) {
+      const auto roots = find_roots(bounds, lon);
+      ASSERT_EQ(roots.size(), discriminant(year, lon));
+      ASSERT_EQ(roots, find_roots(year, lon));
+
+      for (const double root : roots) {
+        ASSERT_GE(root, bounds.start_jde);
+        ASSERT_LT(root, bounds.end_jde);
+        ASSERT_NEAR(astro::toolbox::normalize_pm180(solar_longitude(root) - lon), 0.0, 1e-8);
+
+        // The estimate is close enough for Newton's method to settle in ~2 iterations.
+        const double travelled = root < bounds.start_jde + 180.0 and lon >= bounds.start_lon 
+                               ? lon - bounds.start_lon 
+                               : lon + 360.0 - bounds.start_lon;
+        ASSERT_NEAR(estimate_root(bounds, travelled), root, 0.05);
+      }
+    }
+  }
+
+  // A seed ~0.01 day away takes more than 1 step.
+  const YearBounds bounds = year_bounds(2024);
+  const double root = find_roots(bounds, 0.0)[0];
+  ASSERT_THROW(refine_root(bounds, 0.0, root + 0.01, 1), std::runtime_error);
+  ASSERT_NEAR(refine_root(bounds, 0.0, root + 0.01), root, 1e-8);
+}
+
+
+TEST(Sun, GuardedClassification) {
+  // The low accuracy longitude stays within its tolerance over `LOW_ACCURACY_SPAN`.
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const double jde = astro::julian_day::J2000 + util::random(-36525.0, 36525.0) * LOW_ACCURACY_SPAN;
+    const double Δλ = astro::toolbox::normalize_pm180(low_accuracy_longitude(jde) - solar_longitude(jde));
+    ASSERT_LT(std::abs(Δλ), LOW_ACCURACY_TOLERANCE);
+  }
+
+  // The guarded classification agrees with the one by the apparent longitudes, 
+  // also for the longitudes right at the start and the end of the year, where it falls back to them.
+  for (int32_t year = 1; year <= 6000; year += 13) {
+    const double start_lon = get_start_lon(year);
+    const double end_lon = get_end_lon(year);
+    for (const double lon : { util::random(0.0, 360.0), start_lon, end_lon, start_lon - 1e-9, end_lon + 1e-9, 0.0 }) {
+      const uint32_t expected = static_cast<uint32_t>(start_lon <= lon and lon < 360.0)
+                              + static_cast<uint32_t>(0.0 <= lon and lon < end_lon);
+      ASSERT_EQ(discriminant(year, lon), expected);
+    }
+  }
+}
+
+
 } // namespace astro::sun::test
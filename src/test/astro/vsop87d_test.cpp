@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
+#include <regex>
+#include <format>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include "random.hpp"
 #include "julian_day.hpp"
 #include "vsop87d/vsop87d.hpp"
+#include "vsop87d/kernels.hpp"
 
 namespace astro::vsop87d::test {
 
@@ -32,4 +39,396 @@ TEST(Vsop87d, Evaluate) {
   }
 }
 
+TEST(Vsop87d, SoaLayout) {
+  const auto check = [](const Vsop87dTables& aos_tables, const SoaTables& soa_tables) {
+    ASSERT_EQ(aos_tables.size(), soa_tables.size());
+
+    for (std::size_t i = 0; i < aos_tables.size(); ++i) {
+      const auto& aos = aos_tables[i];
+      const auto& soa = soa_tables[i];
+
+      // Padded to full vectors.
+      ASSERT_EQ(soa.A.size(), simd::padded(aos.size()));
+      ASSERT_EQ(soa.B.size(), soa.A.size());
+      ASSERT_EQ(soa.C.size(), soa.A.size());
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(soa.A.data()) % simd::ALIGNMENT, 0U);
+
+      for (std::size_t j = 0; j < soa.A.size(); ++j) {
+        if (j < aos.size()) {
+          ASSERT_EQ(soa.A[j], aos[j].A);
+          ASSERT_EQ(soa.B[j], aos[j].B);
+          ASSERT_EQ(soa.C[j], aos[j].C);
+        } else { // Padding terms are zeros.
+          ASSERT_EQ(soa.A[j], 0.0);
+          ASSERT_EQ(soa.B[j], 0.0);
+          ASSERT_EQ(soa.C[j], 0.0);
+        }
+      }
+    }
+  };
+
+  check(earth_coeff::L, earth_coeff::L_soa);
+  check(earth_coeff::B, earth_coeff::B_soa);
+  check(earth_coeff::R, earth_coeff::R_soa);
+}
+
+TEST(Vsop87d, SoaEvaluate) {
+  // The SIMD evaluation must agree with the array-of-structs evaluation, over ±10 millennia.
+  for (int i = 0; i < 500; i++) {
+    const double jm = util::random(-10.0, 10.0);
+
+    for (std::size_t k = 0; k < earth_coeff::L.size(); ++k) {
+      ASSERT_NEAR(evaluate_table(earth_coeff::L_soa[k], jm), evaluate_table(earth_coeff::L[k], jm), 1e-11);
+    }
+
+    ASSERT_NEAR(evaluate_tables(earth_coeff::L_soa, jm), evaluate_tables(earth_coeff::L, jm), 1e-9);
+    ASSERT_NEAR(evaluate_tables(earth_coeff::B_soa, jm), evaluate_tables(earth_coeff::B, jm), 1e-12);
+    ASSERT_NEAR(evaluate_tables(earth_coeff::R_soa, jm), evaluate_tables(earth_coeff::R, jm), 1e-12);
+
+    const auto evaluated = evaluate<Planet::EAR>(jm);
+    ASSERT_EQ(evaluated.λ, evaluate_tables(earth_coeff::L_soa, jm));
+    ASSERT_EQ(evaluated.β, evaluate_tables(earth_coeff::B_soa, jm));
+    ASSERT_EQ(evaluated.r, evaluate_tables(earth_coeff::R_soa, jm));
+  }
+}
+
+TEST(Vsop87d, EvaluateBatch) {
+  // Cover a partial tile, a full tile, and several tiles with a partial tail.
+  for (const std::size_t count : { std::size_t { 1 }, std::size_t { 3 }, BATCH_TILE, 3 * BATCH_TILE + 5 }) {
+    std::vector<double> jms(count);
+    for (auto& jm : jms) {
+      jm = util::random(-10.0, 10.0);
+    }
+
+    std::vector<Evaluation> out(count);
+    evaluate_batch<Planet::EAR>(jms, out);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto expected = evaluate<Planet::EAR>(jms[i]);
+      ASSERT_DOUBLE_EQ(out[i].λ, expected.λ);
+      ASSERT_DOUBLE_EQ(out[i].β, expected.β);
+      ASSERT_DOUBLE_EQ(out[i].r, expected.r);
+    }
+  }
+
+  // Empty input.
+  evaluate_batch<Planet::EAR>({}, {});
+
+  // Mismatched sizes.
+  std::vector<double> jms(3, 0.0);
+  std::vector<Evaluation> out(2);
+  ASSERT_THROW(evaluate_batch<Planet::EAR>(jms, out), std::invalid_argument);
+}
+
+TEST(Vsop87d, Stepper) {
+  // One step per minute, and one step per 10 days.
+  for (const double Δjde : { 1.0 / 1440.0, 10.0 }) {
+    const double jm0 = util::random(-1.0, 1.0);
+    const double Δjm = Δjde / 365250.0;
+
+    const StepperOptions options { .reseed_interval = 500, .error_budget = 1e-11 };
+    Vsop87dStepper<Planet::EAR> stepper { jm0, Δjm, options };
+    ASSERT_LE(stepper.reseed_interval(), options.reseed_interval);
+
+    double max_error = 0.0;
+    for (std::size_t n = 0; n < 3000; ++n, stepper.step()) {
+      ASSERT_EQ(stepper.steps(), n);
+      ASSERT_DOUBLE_EQ(stepper.jm(), jm0 + static_cast<double>(n) * Δjm);
+
+      const auto evaluated = stepper.evaluate();
+      const auto expected = evaluate<Planet::EAR>(stepper.jm());
+      max_error = std::max({ 
+        max_error, 
+        std::abs(evaluated.λ - expected.λ), 
+        std::abs(evaluated.β - expected.β), 
+        std::abs(evaluated.r - expected.r) 
+      });
+    }
+
+    ASSERT_LE(max_error, options.error_budget);
+    ASSERT_GE(stepper.reseeds(), 3000 / options.reseed_interval);
+  }
+
+  // Right after (re-)seeding, the results are the same as `evaluate`.
+  Vsop87dStepper<Planet::EAR> stepper { 0.25, 1e-6, { .reseed_interval = 1, .error_budget = 1.0 } };
+  for (std::size_t n = 0; n < 10; ++n, stepper.step()) {
+    const auto evaluated = stepper.evaluate();
+    const auto expected = evaluate<Planet::EAR>(stepper.jm());
+    ASSERT_DOUBLE_EQ(evaluated.λ, expected.λ);
+    ASSERT_DOUBLE_EQ(evaluated.β, expected.β);
+    ASSERT_DOUBLE_EQ(evaluated.r, expected.r);
+  }
+
+  // `fill` gives the same results as calling `evaluate` and `step` alternately, across re-seeds and tiles.
+  Vsop87dStepper<Planet::EAR> filled   { -0.5, 1e-5, { .reseed_interval = 300 } };
+  Vsop87dStepper<Planet::EAR> stepped  { -0.5, 1e-5, { .reseed_interval = 300 } };
+  std::vector<Evaluation> out(1000);
+  filled.fill(std::span { out }.first(7));
+  filled.fill(std::span { out }.subspan(7));
+  ASSERT_EQ(filled.steps(), out.size());
+  for (const auto& result : out) {
+    const auto expected = stepped.evaluate();
+    stepped.step();
+    ASSERT_EQ(result.λ, expected.λ);
+    ASSERT_EQ(result.β, expected.β);
+    ASSERT_EQ(result.r, expected.r);
+  }
+  ASSERT_EQ(filled.reseeds(), stepped.reseeds());
+
+  // A tight budget shortens the re-seed interval.
+  const Vsop87dStepper<Planet::EAR> tight { 0.0, 1e-6, { .reseed_interval = 1000, .error_budget = 1e-15 } };
+  ASSERT_LT(tight.reseed_interval(), 1000U);
+
+  // Invalid options.
+  ASSERT_THROW((Vsop87dStepper<Planet::EAR> { 0.0, 1e-6, { .reseed_interval = 0 } }), std::invalid_argument);
+  ASSERT_THROW((Vsop87dStepper<Planet::EAR> { 0.0, 1e-6, { .error_budget = 0.0 } }), std::invalid_argument);
+}
+
+TEST(Vsop87d, PrecisionTiers) {
+  const auto count_terms = []<Precision precision>() -> std::size_t {
+    using Tier = PlannetTables<Planet::EAR>::Tier<precision>;
+    std::size_t count = 0;
+    for (const auto& tables : { Tier::L, Tier::B, Tier::R }) {
+      for (const SoaTable& table : tables) {
+        count += static_cast<std::size_t>(std::ranges::count_if(table.A, [](const double A) { return A != 0.0; }));
+      }
+    }
+    return count;
+  };
+
+  // The cheaper the tier, the fewer the terms.
+  const std::size_t full       = count_terms.operator()<Precision::FULL>();
+  const std::size_t arcsec     = count_terms.operator()<Precision::ARCSEC>();
+  const std::size_t ten_arcsec = count_terms.operator()<Precision::TEN_ARCSEC>();
+  const std::size_t arcmin     = count_terms.operator()<Precision::ARCMIN>();
+  ASSERT_EQ(full, 2425U);
+  ASSERT_LT(arcsec, full);
+  ASSERT_LT(ten_arcsec, arcsec);
+  ASSERT_LT(arcmin, ten_arcsec);
+
+  // The truncation errors are within the tolerances, for |jm| <= `TRUNCATION_JM`.
+  const auto check = []<Precision precision>() {
+    for (std::size_t i = 0; i < 500; ++i) {
+      const double jm = util::random(-TRUNCATION_JM, TRUNCATION_JM);
+      const auto truncated = evaluate<Planet::EAR, precision>(jm);
+      const auto expected = evaluate<Planet::EAR>(jm);
+      ASSERT_NEAR(truncated.λ, expected.λ, tolerance(precision));
+      ASSERT_NEAR(truncated.β, expected.β, tolerance(precision));
+      ASSERT_NEAR(truncated.r, expected.r, tolerance(precision));
+    }
+  };
+  check.operator()<Precision::ARCSEC>();
+  check.operator()<Precision::TEN_ARCSEC>();
+  check.operator()<Precision::ARCMIN>();
+
+  // The full tier is the untruncated series.
+  const double jm = util::random(-10.0, 10.0);
+  ASSERT_EQ(evaluate<Planet::EAR>(jm).λ, (evaluate<Planet::EAR, Precision::FULL>(jm).λ));
+}
+
+TEST(Vsop87d, EvaluateWithRate) {
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jm = util::random(-2.0, 2.0);
+    const auto [value, rate] = evaluate_with_rate<Planet::EAR>(jm);
+
+    // The values are the same as `evaluate`.
+    const auto expected = evaluate<Planet::EAR>(jm);
+    ASSERT_EQ(value.λ, expected.λ);
+    ASSERT_EQ(value.β, expected.β);
+    ASSERT_EQ(value.r, expected.r);
+
+    // The rates agree with the central differences. The truncation error of the differences is O(h²).
+    const double jm_after = jm + 1e-7;
+    const double jm_before = jm - 1e-7;
+    const double Δjm = jm_after - jm_before;
+    const auto after = evaluate<Planet::EAR>(jm_after);
+    const auto before = evaluate<Planet::EAR>(jm_before);
+    ASSERT_NEAR(rate.λ, (after.λ - before.λ) / Δjm, 1e-3);
+    ASSERT_NEAR(rate.β, (after.β - before.β) / Δjm, 1e-4);
+    ASSERT_NEAR(rate.r, (after.r - before.r) / Δjm, 1e-4);
+  }
+
+  // The rates of the truncated tiers are the derivatives of the truncated series.
+  const double jm = util::random(-1.0, 1.0);
+  const auto [value, rate] = evaluate_with_rate<Planet::EAR, Precision::ARCMIN>(jm);
+  ASSERT_EQ(value.λ, (evaluate<Planet::EAR, Precision::ARCMIN>(jm).λ));
+  // 1 rad per julian millennium is about 1.6e-4 degrees per day.
+  ASSERT_NEAR(rate.λ, evaluate_with_rate<Planet::EAR>(jm).rate.λ, 1.0);
+}
+
+TEST(Vsop87d, MixedPrecision) {
+  // Every term is either in the head or in the tail.
+  using Tier = PlannetTables<Planet::EAR>::Tier<Precision::MIXED>;
+  std::size_t head = 0;
+  std::size_t tail = 0;
+  for (const auto& tables : { Tier::L_mixed, Tier::B_mixed, Tier::R_mixed }) {
+    for (const MixedTable& table : tables) {
+      head += static_cast<std::size_t>(std::ranges::count_if(table.head.A, [](const double A) { return A != 0.0; }));
+      tail += static_cast<std::size_t>(std::ranges::count_if(table.tail.A, [](const float A) { return A != 0.0F; }));
+    }
+  }
+  ASSERT_EQ(head + tail, 2425U);
+  ASSERT_LT(head, tail);
+
+  // Only the rounding of the tail differs from the full series, over ±4000 years.
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const double jm = util::random(-4.0, 4.0);
+    const auto mixed = evaluate<Planet::EAR, Precision::MIXED>(jm);
+    const auto expected = evaluate<Planet::EAR>(jm);
+    ASSERT_NEAR(mixed.λ, expected.λ, MIXED_TOLERANCE);
+    ASSERT_NEAR(mixed.β, expected.β, MIXED_TOLERANCE);
+    ASSERT_NEAR(mixed.r, expected.r, MIXED_TOLERANCE);
+  }
+
+  // The rates are of the mixed-precision series, with the same values as `evaluate`.
+  for (std::size_t i = 0; i < 200; ++i) {
+    const double jm = util::random(-4.0, 4.0);
+    const auto [value, rate] = evaluate_with_rate<Planet::EAR, Precision::MIXED>(jm);
+    const auto mixed = evaluate<Planet::EAR, Precision::MIXED>(jm);
+    ASSERT_EQ(value.λ, mixed.λ);
+    ASSERT_EQ(value.β, mixed.β);
+    ASSERT_EQ(value.r, mixed.r);
+
+    const auto expected = evaluate_with_rate<Planet::EAR>(jm).rate;
+    ASSERT_NEAR(rate.λ, expected.λ, 1e-6);
+    ASSERT_NEAR(rate.β, expected.β, 1e-6);
+    ASSERT_NEAR(rate.r, expected.r, 1e-6);
+  }
+}
+
+TEST(Vsop87d, GeneratedKernels) {
+  // The generated kernels agree with the generic evaluation up to rounding, see `astro::vsop87d::kernels`.
+  const auto check = []<Precision precision>() {
+    for (std::size_t i = 0; i < 500; ++i) {
+      const double jm = util::random(-1.0, 1.0);
+      const auto generated = kernels::evaluate<Planet::EAR, precision>(jm);
+      const auto expected = evaluate<Planet::EAR, precision>(jm);
+      ASSERT_NEAR(generated.λ, expected.λ, 5e-11);
+      ASSERT_NEAR(generated.β, expected.β, 1e-13);
+      ASSERT_NEAR(generated.r, expected.r, 1e-13);
+    }
+  };
+  check.operator()<Precision::FULL>();
+  check.operator()<Precision::ARCSEC>();
+  check.operator()<Precision::TEN_ARCSEC>();
+  check.operator()<Precision::ARCMIN>();
+}
+
+/**
+ * @brief Write the built-in tables of the Earth in the format of the VSOP87D distribution files, labelled as the given planet.
+ * @note The columns follow the FORTRAN format of the distribution: 1x,4i1,i5,12i3,f15.11,2f18.11,f14.11,f20.11.
+ */
+auto write_vsop87d_file(std::ostream& out, const Planet planet) -> void {
+  const std::array<Vsop87dTables, 3> series { earth_coeff::L, earth_coeff::B, earth_coeff::R };
+  for (std::size_t variable = 0; variable < series.size(); ++variable) {
+    for (std::size_t power = 0; power < series[variable].size(); ++power) {
+      const Vsop87dTable table = series[variable][power];
+      out << std::format(
+        " VSOP87 VERSION D{}    {:<10}VARIABLE {} (LBR)       *T**{} {:7} TERMS    HELIOCENTRIC DYNAMICAL ECLIPTIC AND EQUINOX OF THE DATE\n",
+        vsop87d_index(planet), vsop87d_name(planet), variable + 1, power, table.size()
+      );
+      for (std::size_t n = 0; n < table.size(); ++n) {
+        out << std::format(" 4{}{}{}{:5}", vsop87d_index(planet), variable + 1, power, n + 1);
+        for (std::size_t i = 0; i < 12; ++i) {
+          out << "  0";
+        }
+        const auto& [A, B, C] = table[n];
+        out << std::format("{:15.11f}{:18.11f}{:18.11f}{:14.11f}{:20.11f}\n", 0.0, 0.0, A / SCALING_FACTOR, B, C);
+      }
+    }
+  }
+}
+
+TEST(Vsop87d, LoaderParse) {
+  std::stringstream file;
+  write_vsop87d_file(file, Planet::EAR);
+  const auto loaded = LoadedTables::parse(file, Planet::EAR);
+  ASSERT_EQ(loaded.term_count(), 2425U);
+  ASSERT_EQ(loaded.L().size(), 6U);
+  ASSERT_EQ(loaded.B().size(), 5U);
+  ASSERT_EQ(loaded.R().size(), 6U);
+
+  // The tables are aligned and padded, like the built-in ones.
+  for (const SoaTable& table : loaded.L()) {
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(table.A.data()) % simd::ALIGNMENT, 0U); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    ASSERT_EQ(table.A.size() % simd::LANES, 0U);
+  }
+
+  // The loaded tables evaluate to the built-in ones. The "A"s are rescaled from the 11-decimal text, hence the rounding.
+  for (std::size_t i = 0; i < 100; ++i) {
+    const double jm = util::random(-1.0, 1.0);
+    const auto expected = evaluate<Planet::EAR>(jm);
+    ASSERT_NEAR(evaluate_tables(loaded.L(), jm), expected.λ, 1e-11);
+    ASSERT_NEAR(evaluate_tables(loaded.B(), jm), expected.β, 1e-13);
+    ASSERT_NEAR(evaluate_tables(loaded.R(), jm), expected.r, 1e-13);
+  }
+
+  // Malformed files are rejected.
+  const auto parse = [](const std::string& text, const Planet planet = Planet::EAR) {
+    std::istringstream in { text };
+    return LoadedTables::parse(in, planet);
+  };
+  const std::string text = file.str();
+  const std::string header = text.substr(0, text.find('\n') + 1);
+  const std::string term = text.substr(header.size(), text.find('\n', header.size()) + 1 - header.size());
+  const std::string without_last_term = text.substr(0, text.rfind('\n', text.size() - 2) + 1);
+  const auto replace = [&text](const std::string& from, const std::string& to) {
+    return std::regex_replace(text, std::regex { from }, to);
+  };
+
+  ASSERT_THROW(parse(text, Planet::MAR), std::runtime_error);                           // Another planet.
+  ASSERT_THROW(parse(""), std::runtime_error);                                          // No tables.
+  ASSERT_THROW(parse(term + text), std::runtime_error);                                 // A term before any header.
+  ASSERT_THROW(parse(without_last_term), std::runtime_error);                           // Fewer terms than declared.
+  ASSERT_THROW(parse(header + term + text), std::runtime_error);                        // Fewer terms than declared.
+  ASSERT_THROW(parse(replace("VERSION D", "VERSION C")), std::runtime_error);           // VSOP87C.
+  ASSERT_THROW(parse(replace("VARIABLE 2", "VARIABLE 4")), std::runtime_error);         // Invalid variable.
+  ASSERT_THROW(parse(replace(R"(\*T\*\*1)", "*T**2")), std::runtime_error);              // A gap in the powers.
+  ASSERT_THROW(parse(replace("1.75347045673", "1.7534x045673")), std::runtime_error);  // Invalid number.
+}
+
+TEST(Vsop87d, LoaderRegistry) {
+  // The Mars file is not loaded yet.
+  ASSERT_FALSE(is_loaded<Planet::MAR>());
+  ASSERT_TRUE(is_loaded<Planet::EAR>());
+  ASSERT_THROW(evaluate<Planet::MAR>(0.0), std::runtime_error);
+  ASSERT_THROW(load<Planet::MAR>("/nonexistent/VSOP87D.mar"), std::runtime_error);
+  ASSERT_FALSE(is_loaded<Planet::MAR>());
+
+  // For the test, the Earth's coefficients are labelled as Mars.
+  const auto path = std::filesystem::temp_directory_path() / "vsop87d_test.mar";
+  {
+    std::ofstream out { path };
+    write_vsop87d_file(out, Planet::MAR);
+  }
+  load(Planet::MAR, path);
+  ASSERT_TRUE(is_loaded<Planet::MAR>());
+  ASSERT_THROW(load<Planet::MAR>(path), std::runtime_error);
+  ASSERT_THROW(load(Planet::EAR, path), std::invalid_argument);
+
+  std::ifstream in { path };
+  const auto expected_tables = LoadedTables::parse(in, Planet::MAR);
+  std::filesystem::remove(path);
+
+  // The registered planet works with every evaluator.
+  std::vector<double> jms(100);
+  for (double& jm : jms) {
+    jm = util::random(-1.0, 1.0);
+  }
+  std::vector<Evaluation> batch(jms.size());
+  evaluate_batch<Planet::MAR>(jms, batch);
+
+  for (std::size_t i = 0; i < jms.size(); ++i) {
+    const auto evaluated = evaluate<Planet::MAR>(jms[i]);
+    ASSERT_EQ(evaluated.λ, evaluate_tables(expected_tables.L(), jms[i]));
+    ASSERT_EQ(evaluated.β, evaluate_tables(expected_tables.B(), jms[i]));
+    ASSERT_EQ(evaluated.r, evaluate_tables(expected_tables.R(), jms[i]));
+    ASSERT_NEAR(evaluated.λ, evaluate<Planet::EAR>(jms[i]).λ, 1e-11);
+    ASSERT_NEAR(batch[i].λ, evaluated.λ, 1e-12);
+  }
+
+  Vsop87dStepper<Planet::MAR> stepper { 0.0, 1.0 / 365250.0 };
+  ASSERT_NEAR(stepper.evaluate().r, evaluate<Planet::MAR>(0.0).r, 1e-12);
+}
+
 }  // namespace astro::vsop87d::test
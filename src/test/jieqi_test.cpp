@@ -95,6 +95,30 @@ TEST(JieQi, JDE) {
   }
 }
 
+TEST(JieQi, SolveYear) {
+  for (int32_t year = 1; year <= 6000; year += util::random(50, 150)) {
+    const auto jdes = solve_year_jieqis(year);
+
+    for (const auto jq : JIEQI_LIST) {
+      const auto jde = jdes[to_index(jq)];
+      ASSERT_NEAR(jde, calc_jieqi_jde(year, jq), 1e-8);
+      ASSERT_EQ(jde, jieqi_jde(year, jq));
+
+      const auto lon_diff = astro::toolbox::normalize_pm180(solar_longitude(jde) - JIEQI_SOLAR_LONGITUDE.at(jq));
+      ASSERT_LT(std::fabs(lon_diff), 2e-9);
+    }
+  }
+
+  // In 8845, the low accuracy longitude at the start of the year is past 285°, while 小寒 is ~0.14 day after the start.
+  // In 8889, 小寒 is at the end of the year instead.
+  for (const int32_t year : { 8845, 8889 }) {
+    ASSERT_NEAR(solve_year_jieqis(year)[to_index(Jieqi::XIAOHAN)], calc_jieqi_jde(year, Jieqi::XIAOHAN), 1e-8);
+  }
+
+  // A seed is ~0.02 day away from its root, so 1 iteration does not converge, and the sweep stops there.
+  ASSERT_THROW(solve_year_jieqis(2024, 1), std::runtime_error);
+}
+
 TEST(JieQi, JDEOrder) {
   const auto year = util::random(1900, 2050);
   
@@ -163,4 +187,38 @@ TEST(JieQi, Generator) {
   ASSERT_TRUE(std::is_sorted(cbegin(jdes), cend(jdes)));
 }
 
+
+TEST(JieQi, GeneratorStart) {
+  // The first jieqi after the given JDE, found among the jieqis of the years around it.
+  const auto first_after = [](const int32_t year, const double start_jde) -> std::pair<Jieqi, double> {
+    std::pair<Jieqi, double> first { Jieqi::小寒, INFINITY };
+    for (const auto y : { year - 1, year, year + 1 }) {
+      for (const auto jq : JIEQI_LIST) {
+        const auto jde = jieqi_jde(y, jq);
+        if (jde > start_jde and jde < first.second) {
+          first = { jq, jde };
+        }
+      }
+    }
+    return first;
+  };
+
+  for (int32_t year = 402; year <= 5000; year += 37) {
+    const auto jq = from_index(util::random(0, JIEQI_COUNT - 1));
+    const auto jde = jieqi_jde(year, jq);
+
+    // Far from a jieqi, right at the jieqis (where the low accuracy longitude falls back), and around the new year.
+    for (const double start_jde : {
+      jde + util::random(-15.0, 15.0), jde, jde - 1e-6, jde + 1e-6,
+      get_start_jde(year), get_start_jde(year) - 1e-6, get_start_jde(year) + util::random(-10.0, 10.0),
+    }) {
+      JieqiGenerator jieqi_gen { start_jde };
+      const auto [expected_jq, expected_jde] = first_after(year, start_jde);
+      const auto [next_jq, next_jde] = jieqi_gen.next();
+      ASSERT_EQ(next_jq, expected_jq);
+      ASSERT_EQ(next_jde, expected_jde);
+    }
+  }
+}
+
 } // namespace calendar::jieqi::test
@@ -0,0 +1,157 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Benchmark the nutation models against each other.
+// 1. For every model, `compute` and `compute_with_rate` are timed on the same epochs, 
+//    and the largest differences of Δψ and Δε from IAU 2000B (the most accurate model here) are reported.
+// 2. For the models in the IAU 1980 layout, the kernel specialized at compile time (`compute<model>`) is timed against
+//    the loops over the runtime tables: one with `gen_eval_θ` and a trigonometric call per term, and one with the harmonics.
+//
+// Usage: bench_nutation [epochs]
+
+#include <cmath>
+#include <span>
+#include <print>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+#include "earth.hpp"
+
+using astro::earth::nutation::Model;
+using astro::earth::nutation::Nutation;
+
+
+/** @brief Return the time per call of the function, in nanoseconds, the fastest of a few rounds. */
+auto time(const std::function<double(double)>& function, const std::vector<double>& jdes) -> double {
+  constexpr std::size_t ROUNDS = 10;
+
+  double ns_per_call = INFINITY;
+  double sink = 0.0; // Keeps the calls from being optimized away.
+  for (std::size_t round = 0; round < ROUNDS; ++round) {
+    const auto begin = std::chrono::steady_clock::now();
+    for (const double jde : jdes) {
+      sink += function(jde);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    ns_per_call = std::min(ns_per_call, elapsed.count() / static_cast<double>(jdes.size()));
+  }
+  return std::isnan(sink) ? INFINITY : ns_per_call;
+}
+
+
+/** @brief Benchmark the given model, and compare it with IAU 2000B. */
+auto bench(const std::string_view name, const Model model, const std::vector<double>& jdes) -> void {
+  namespace nutation = astro::earth::nutation;
+
+  double max_Δψ = 0.0;
+  double max_Δε = 0.0;
+  for (const double jde : jdes) {
+    const Nutation value = nutation::compute(jde, model);
+    const Nutation reference = nutation::compute(jde, Model::IAU_2000B);
+    max_Δψ = std::max(max_Δψ, std::abs((value.Δψ - reference.Δψ).deg()) * 3600.0);
+    max_Δε = std::max(max_Δε, std::abs((value.Δε - reference.Δε).deg()) * 3600.0);
+  }
+
+  const double compute_ns = time([model](const double jde) { 
+    return nutation::compute(jde, model).Δψ.deg(); 
+  }, jdes);
+  const double with_rate_ns = time([model](const double jde) { 
+    return nutation::compute_with_rate(jde, model).Δψ_rate; 
+  }, jdes);
+
+  const std::size_t terms = model == Model::IAU_2000B ? nutation::IAU2000B_NUTATION_COEFFS.size() : nutation::find_model(model).size();
+  std::println("{:<12}{:>8}{:>16.1f}{:>16.1f}{:>12.4f}{:>12.4f}", name, terms, compute_ns, with_rate_ns, max_Δψ, max_Δε);
+}
+
+
+/** @brief Δψ with `gen_eval_θ`, and a trigonometric call per term, in degrees. */
+auto per_term_trig(const double jde, const Model model) -> double {
+  namespace nutation = astro::earth::nutation;
+
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  const auto eval_θ = nutation::gen_eval_θ(jc);
+  double sum = 0.0;
+  for (const auto& [θ, Δψ, Δε] : nutation::find_model(model)) {
+    sum += (Δψ.coeff1 + Δψ.coeff2 * jc) * std::sin(eval_θ(θ).rad());
+  }
+  return sum * 0.0001 / 3600.0;
+}
+
+
+/** @brief Δψ with the harmonics, looping over the runtime table, in degrees. */
+auto runtime_loop(const double jde, const Model model) -> double {
+  namespace nutation = astro::earth::nutation;
+
+  const double jc = astro::julian_day::jde_to_jc(jde);
+  const auto harmonics = nutation::make_harmonic_arguments(nutation::fundamental_arguments(jc));
+  double sum = 0.0;
+  for (const auto& [θ, Δψ, Δε] : nutation::find_model(model)) {
+    sum += (Δψ.coeff1 + Δψ.coeff2 * jc) * harmonics.θ(θ).sin;
+  }
+  return sum * 0.0001 / 3600.0;
+}
+
+
+/** @brief Benchmark the specialized kernel of the given model against the runtime loops. */
+template <Model model>
+auto bench_kernel(const std::string_view name, const std::vector<double>& jdes) -> void {
+  namespace nutation = astro::earth::nutation;
+
+  const double trig_ns = time([](const double jde) { return per_term_trig(jde, model); }, jdes);
+  const double loop_ns = time([](const double jde) { return runtime_loop(jde, model); }, jdes);
+  const double kernel_ns = time([](const double jde) { return nutation::compute<model>(jde).Δψ.deg(); }, jdes);
+
+  double max_diff = 0.0;
+  for (const double jde : jdes) {
+    max_diff = std::max(max_diff, std::abs(nutation::compute<model>(jde).Δψ.deg() - per_term_trig(jde, model)) * 3600.0);
+  }
+  std::println("{:<12}{:>16.1f}{:>16.1f}{:>16.1f}{:>10.2f}x{:>12.1e}", 
+    name, trig_ns, loop_ns, kernel_ns, trig_ns / kernel_ns, max_diff);
+}
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  const std::size_t count = args.size() > 1 ? std::stoul(args[1]) : 20000;
+
+  // The epochs are spread evenly over the years 1000 to 3000.
+  std::vector<double> jdes(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    jdes[i] = astro::julian_day::J2000 + 365250.0 * (-1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(count));
+  }
+
+  std::println("{} epochs over the years 1000 to 3000, SIMD lanes: {}\n", count, astro::simd::LANES);
+  std::println("{:<12}{:>8}{:>16}{:>16}{:>12}{:>12}", "Model", "Terms", "compute (ns)", "with rate (ns)", "Δψ vs 2000B", "Δε vs 2000B");
+  bench("MEEUS", Model::MEEUS, jdes);
+  bench("IAU_1980", Model::IAU_1980, jdes);
+  bench("IAU_2000B", Model::IAU_2000B, jdes);
+
+  std::println("\n{:<12}{:>16}{:>16}{:>16}{:>11}{:>12}", "Model", "gen_eval_θ (ns)", "Runtime (ns)", "compute<> (ns)", "Speedup", "Max diff Δψ");
+  bench_kernel<Model::MEEUS>("MEEUS", jdes);
+  bench_kernel<Model::IAU_1980>("IAU_1980", jdes);
+
+  return 0;
+}
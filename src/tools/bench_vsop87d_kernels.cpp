@@ -0,0 +1,134 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Benchmark the generated VSOP87D kernels (see `astro::vsop87d::kernels`) against `evaluate_tables`.
+// For every precision tier, the generic evaluation and the generated kernel are timed on the same epochs,
+// and the largest difference between them is reported.
+//
+// Usage: bench_vsop87d_kernels [epochs]
+
+#include <cmath>
+#include <print>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+#include "vsop87d/vsop87d.hpp"
+#include "vsop87d/kernels.hpp"
+
+using astro::vsop87d::Planet;
+using astro::vsop87d::Precision;
+using astro::vsop87d::Evaluation;
+
+
+/** @struct The result of timing an evaluator. */
+struct Timing {
+  double ns_per_epoch;
+  std::vector<Evaluation> results;
+};
+
+
+/** @brief Time the evaluator on all the epochs, and keep the fastest of a few rounds. */
+auto time(const std::function<Evaluation(double)>& evaluator, const std::vector<double>& jms) -> Timing {
+  constexpr std::size_t ROUNDS = 5;
+
+  Timing timing { .ns_per_epoch = INFINITY, .results = std::vector<Evaluation>(jms.size()) };
+  for (std::size_t round = 0; round < ROUNDS; ++round) {
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < jms.size(); ++i) {
+      timing.results[i] = evaluator(jms[i]);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    timing.ns_per_epoch = std::min(timing.ns_per_epoch, elapsed.count() / static_cast<double>(jms.size()));
+  }
+  return timing;
+}
+
+
+/** @brief Return the largest difference between the two sets of results, over λ, β and r. */
+auto max_difference(const std::vector<Evaluation>& lhs, const std::vector<Evaluation>& rhs) -> double {
+  double difference = 0.0;
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    difference = std::max({ 
+      difference, 
+      std::abs(lhs[i].λ - rhs[i].λ), 
+      std::abs(lhs[i].β - rhs[i].β), 
+      std::abs(lhs[i].r - rhs[i].r),
+    });
+  }
+  return difference;
+}
+
+
+/** @brief Benchmark the generated kernel of the given precision tier against `evaluate_tables`. */
+template <Precision precision>
+auto bench(const std::string_view name, const std::vector<double>& jms) -> void {
+  using Tier = astro::vsop87d::PlannetTables<Planet::EAR>::Tier<precision>;
+
+  const auto generic = time([](const double jm) -> Evaluation {
+    return {
+      .λ = astro::vsop87d::evaluate_tables(Tier::L, jm),
+      .β = astro::vsop87d::evaluate_tables(Tier::B, jm),
+      .r = astro::vsop87d::evaluate_tables(Tier::R, jm),
+    };
+  }, jms);
+  const auto generated = time(astro::vsop87d::kernels::evaluate<Planet::EAR, precision>, jms);
+
+  std::println("{:<12}{:>16.1f}{:>16.1f}{:>10.2f}x{:>16.2e}", 
+    name, generic.ns_per_epoch, generated.ns_per_epoch, generic.ns_per_epoch / generated.ns_per_epoch,
+    max_difference(generic.results, generated.results));
+}
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  const std::size_t count = args.size() > 1 ? std::stoul(args[1]) : 20000;
+
+  // The epochs are spread evenly over the years 1000 to 3000.
+  std::vector<double> jms(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    jms[i] = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(count);
+  }
+
+  // The array-of-structs tables, which are iterated through spans of spans with ranges adapters.
+  const auto aos = time([](const double jm) -> Evaluation {
+    using Tables = astro::vsop87d::PlannetTables<Planet::EAR>;
+    return {
+      .λ = astro::vsop87d::evaluate_tables(Tables::L, jm),
+      .β = astro::vsop87d::evaluate_tables(Tables::B, jm),
+      .r = astro::vsop87d::evaluate_tables(Tables::R, jm),
+    };
+  }, jms);
+  std::println("Planet::EAR, {} epochs, SIMD lanes: {}", count, astro::simd::LANES);
+  std::println("Array-of-structs evaluate_tables (FULL): {:.1f} ns/epoch\n", aos.ns_per_epoch);
+
+  std::println("{:<12}{:>16}{:>16}{:>11}{:>16}", "Precision", "SoA (ns/epoch)", "Kernel", "Speedup", "Max diff");
+  bench<Precision::FULL>("FULL", jms);
+  bench<Precision::ARCSEC>("ARCSEC", jms);
+  bench<Precision::TEN_ARCSEC>("TEN_ARCSEC", jms);
+  bench<Precision::ARCMIN>("ARCMIN", jms);
+
+  return 0;
+}
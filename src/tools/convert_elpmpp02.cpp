@@ -0,0 +1,81 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Convert the six ASCII files of the ELP/MPP02 distribution (ELP_MAIN.S1, ..., ELP_PERT.S3) to the compact binary file,
+// which `astro::elpmpp02::load` reads. The binary file is checked by reading it back.
+//
+// Usage: convert_elpmpp02 <distribution-dir> <output-path>
+
+#include <print>
+#include <span>
+#include <string>
+#include <fstream>
+#include <exception>
+#include <filesystem>
+
+#include "elpmpp02/elpmpp02.hpp"
+
+namespace elpmpp02 = astro::elpmpp02;
+
+
+auto main(const int argc, char* argv[]) -> int {
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  if (args.size() != 3) {
+    std::println("Usage: {} <distribution-dir> <output-path>", args[0]);
+    return 1;
+  }
+  const std::filesystem::path directory { args[1] };
+  const std::filesystem::path output { args[2] };
+
+  try {
+    const auto coefficients = elpmpp02::load_ascii(directory);
+    {
+      std::ofstream out { output, std::ios::binary };
+      elpmpp02::write_binary(out, coefficients);
+      if (not out) {
+        std::println("Failed to write {}", output.string());
+        return 1;
+      }
+    }
+
+    const auto loaded = elpmpp02::load_binary(output);
+    if (loaded.term_count() != coefficients.term_count()) {
+      std::println("The binary file holds {} terms, but {} were parsed", loaded.term_count(), coefficients.term_count());
+      return 1;
+    }
+
+    const std::array<std::string_view, elpmpp02::VARIABLES> names { "Longitude", "Latitude", "Distance" };
+    for (std::size_t variable = 0; variable < elpmpp02::VARIABLES; ++variable) {
+      std::print("{:<10} main problem: {:5} terms, perturbations:", names.at(variable), coefficients.main.at(variable).size());
+      for (std::size_t power = 0; power < elpmpp02::POWERS; ++power) {
+        std::print(" {:5} (t^{})", coefficients.perturbation.at(variable).at(power).size(), power);
+      }
+      std::println("");
+    }
+    std::println("Wrote {} terms to {}, {} bytes", coefficients.term_count(), output.string(), std::filesystem::file_size(output));
+  } catch (const std::exception& e) {
+    std::println("{}", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Solve the new moons and write the new moon table file, or verify a table file against the live ephemeris.
+// See `astro::new_moon_table` and `astro::moon_phase::new_moon::use_table`.
+//
+// Usage: gen_new_moon_table <output-path> [start-year] [end-year]
+//        gen_new_moon_table --verify <path> [stride]
+// By default, the years -2000 to 4000 are covered, and every 97th lunation is verified.
+
+#include <print>
+#include <string>
+#include <chrono>
+#include <exception>
+
+#include "moon_phase.hpp"
+#include "julian_day.hpp"
+
+
+/** @brief Solve a sample of the lunations in the table again, and report the largest difference. */
+auto verify(const std::string& path, const int64_t stride) -> int {
+  const astro::new_moon_table::Table table { path };
+  std::println("Verifying {} (lunations {} to {}), every {} lunations...", path, table.first_lunation(), table.last_lunation(), stride);
+
+  const auto begin = std::chrono::steady_clock::now();
+  const auto [count, max_diff] = astro::moon_phase::new_moon::verify_table(table, stride);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  // A table solved with the same ephemeris is within half of the fixed-point unit.
+  const bool passed = max_diff <= astro::new_moon_table::UNIT;
+  std::println("{} lunations solved in {:.1f}s, max diff {:.3e} seconds: {}", count, elapsed.count(), max_diff * 86400.0, passed ? "OK" : "DRIFTED");
+  return passed ? 0 : 1;
+}
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  if (args.size() < 2 or args.size() > 4) {
+    std::println("Usage: {} <output-path> [start-year] [end-year]", args[0]);
+    std::println("       {} --verify <path> [stride]", args[0]);
+    return 1;
+  }
+
+  try {
+    if (std::string { args[1] } == "--verify") {
+      if (args.size() < 3) {
+        std::println("Missing the path of the table to verify.");
+        return 1;
+      }
+      return verify(args[2], args.size() > 3 ? std::stoll(args[3]) : 97);
+    }
+
+    const std::string path { args[1] };
+    const int32_t start_year = args.size() > 2 ? std::stoi(args[2]) : -2000;
+    const int32_t end_year   = args.size() > 3 ? std::stoi(args[3]) : 4000;
+
+    // The calendars start at year 1, so the years are converted with the mean Gregorian year.
+    // It's within a day, and the table holds one more new moon on each side of the range anyway.
+    const auto year_to_jde = [](const int32_t year) -> double {
+      return astro::julian_day::J2000 - 0.5 + 365.2425 * static_cast<double>(year - 2000);
+    };
+
+    std::println("Generating {} for years [{}, {})...", path, start_year, end_year);
+    const auto begin = std::chrono::steady_clock::now();
+
+    astro::moon_phase::new_moon::generate_table(path, year_to_jde(start_year), year_to_jde(end_year));
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    const astro::new_moon_table::Table table { path };
+    std::println("Done in {:.1f}s: {} new moons, {} bytes.", elapsed.count(), table.header().count, 
+      sizeof(astro::new_moon_table::Header) + table.header().count * sizeof(int32_t));
+
+  } catch (const std::exception& e) {
+    std::println("Failed: {}", e.what());
+    return 1;
+  }
+
+  return 0;
+}
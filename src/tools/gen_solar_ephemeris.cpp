@@ -0,0 +1,77 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Fit the apparent position of the Sun with Chebyshev series, and write the ephemeris file.
+// See `astro::ephemeris` and `astro::sun::geocentric_coord::use_ephemeris`.
+//
+// Usage: gen_solar_ephemeris <output-path> [start-year] [end-year] [granule-days]
+// By default, the years -4000 to 8000 are covered, with 32-day granules.
+
+#include <print>
+#include <string>
+#include <chrono>
+#include <exception>
+
+#include "sun.hpp"
+#include "julian_day.hpp"
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  if (args.size() < 2 or args.size() > 5) {
+    std::println("Usage: {} <output-path> [start-year] [end-year] [granule-days]", args[0]);
+    return 1;
+  }
+
+  try {
+    const std::string path { args[1] };
+    const int32_t start_year = args.size() > 2 ? std::stoi(args[2]) : -4000;
+    const int32_t end_year   = args.size() > 3 ? std::stoi(args[3]) : 8000;
+
+    astro::ephemeris::GenerateOptions options;
+    if (args.size() > 4) {
+      options.granule_days = std::stod(args[4]);
+    }
+
+    // The ephemeris is indexed by JDE, so the years are converted as TT.
+    const auto year_to_jde = [](const int32_t year) -> double {
+      return astro::julian_day::tt_to_jde(calendar::Datetime { util::to_ymd(year, 1, 1), 0.0 });
+    };
+    const double start_jde = year_to_jde(start_year);
+    const double end_jde = year_to_jde(end_year);
+
+    std::println("Generating {} for years [{}, {}), with {}-day granules...", path, start_year, end_year, options.granule_days);
+    const auto begin = std::chrono::steady_clock::now();
+
+    astro::sun::geocentric_coord::generate_ephemeris(path, start_jde, end_jde, options);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    std::println("Done in {:.1f}s.", elapsed.count());
+
+  } catch (const std::exception& e) {
+    std::println("Failed: {}", e.what());
+    return 1;
+  }
+
+  return 0;
+}
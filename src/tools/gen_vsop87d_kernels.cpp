@@ -0,0 +1,238 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Generate the specialized VSOP87D kernels, one translation unit per planet and precision tier.
+// See `astro::vsop87d::kernels`.
+//
+// Usage: gen_vsop87d_kernels <output-dir>
+// The files are named after the planet and the tier, e.g. `ear_full.cpp`.
+
+#include <cmath>
+#include <cctype>
+#include <print>
+#include <format>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <exception>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+
+#include "vsop87d/vsop87d.hpp"
+#include "vsop87d/kernels.hpp"
+
+using astro::vsop87d::Planet;
+using astro::vsop87d::Precision;
+using astro::vsop87d::SoaTable;
+using astro::vsop87d::SoaTables;
+using astro::vsop87d::PlannetTables;
+
+
+/** @struct A VSOP87D table, prepared for the generated kernel. */
+struct PreparedTable {
+  double constant;        // The sum of the terms with C = 0, divided by `SCALING_FACTOR`.
+  std::size_t count;      // The number of the periodic terms, i.e. the terms with C != 0.
+  std::vector<double> A;  // Divided by `SCALING_FACTOR`, zero-padded to a multiple of `BLOCK`.
+  std::vector<double> B;
+  std::vector<double> C;
+};
+
+
+/** @brief Fold the constant terms, pre-divide the "A"s, and pad the table to full blocks. */
+auto prepare(const SoaTable& table) -> PreparedTable {
+  using astro::vsop87d::SCALING_FACTOR;
+
+  PreparedTable prepared { .constant = 0.0, .count = 0, .A = {}, .B = {}, .C = {} };
+  for (std::size_t i = 0; i < table.A.size(); ++i) {
+    if (table.A[i] == 0.0) {
+      continue; // Padding of the SoA storage.
+    }
+    if (table.C[i] == 0.0) {
+      prepared.constant += table.A[i] * std::cos(table.B[i]) / SCALING_FACTOR;
+      continue;
+    }
+    prepared.A.push_back(table.A[i] / SCALING_FACTOR);
+    prepared.B.push_back(table.B[i]);
+    prepared.C.push_back(table.C[i]);
+  }
+
+  using astro::vsop87d::kernels::BLOCK;
+  prepared.count = prepared.A.size();
+  const std::size_t size = (prepared.A.size() + BLOCK - 1) / BLOCK * BLOCK;
+  prepared.A.resize(size, 0.0);
+  prepared.B.resize(size, 0.0);
+  prepared.C.resize(size, 0.0);
+  return prepared;
+}
+
+
+/** @brief Write the values as the body of a braced initializer. The shortest representation round-trips exactly. */
+auto write_values(std::ofstream& out, const std::vector<double>& values) -> void {
+  constexpr std::size_t PER_LINE = 4;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    out << std::format("{}{},", i % PER_LINE == 0 ? "\n    " : " ", values[i]);
+  }
+  out << std::format("\n  ");
+}
+
+
+/**
+ * @brief Write the tables of a series (e.g. L), and return the expression of the series as a polynomial in `jm`.
+ * @param out The output stream.
+ * @param name The name of the series, i.e. "L", "B" or "R".
+ * @param tables The SoA tables of the series.
+ * @param body The statements of the kernel, to which the sums of the tables are appended.
+ */
+auto write_series(std::ofstream& out, const std::string_view name, const SoaTables& tables, std::string& body) -> std::string {
+  std::vector<PreparedTable> prepared;
+  for (const SoaTable& table : tables) {
+    prepared.push_back(prepare(table));
+  }
+
+  // The trailing powers that are truncated entirely are left out of the polynomial.
+  const auto is_zero = [](const PreparedTable& table) { return table.A.empty() and table.constant == 0.0; };
+  while (not prepared.empty() and is_zero(prepared.back())) {
+    prepared.pop_back();
+  }
+  if (prepared.empty()) {
+    return "0.0";
+  }
+
+  std::vector<std::string> powers;
+  for (std::size_t k = 0; k < prepared.size(); ++k) {
+    const auto& [constant, count, A, B, C] = prepared[k];
+    const std::string table_name = std::format("{}{}", name, k);
+    powers.push_back(table_name);
+
+    if (A.empty()) {
+      body += std::format("  constexpr double {} = {};\n", table_name, constant);
+      continue;
+    }
+
+    out << std::format("// {}: {} periodic term{}, padded to {}.\n", table_name, count, count == 1 ? "" : "s", A.size());
+    out << std::format("constexpr Terms<{}> {}_TERMS {{\n", A.size(), table_name);
+    out << "  .A = {";
+    write_values(out, A);
+    out << "},\n  .B = {";
+    write_values(out, B);
+    out << "},\n  .C = {";
+    write_values(out, C);
+    out << "},\n};\n\n";
+
+    const std::string sum = std::format("sum_terms<{}>({}_TERMS, jm)", count, table_name);
+    body += constant == 0.0
+          ? std::format("  const double {} = {};\n", table_name, sum)
+          : std::format("  const double {} = {} + {};\n", table_name, sum, constant);
+  }
+
+  // Unroll Horner's method, e.g. L0 + jm * (L1 + jm * L2).
+  std::string polynomial = powers.back();
+  for (std::size_t k = powers.size() - 1; k-- > 0;) {
+    polynomial = k + 2 == powers.size()
+               ? std::format("{} + jm * {}", powers[k], polynomial)
+               : std::format("{} + jm * ({})", powers[k], polynomial);
+  }
+  return polynomial;
+}
+
+
+/** @brief Return the lowercase copy of the given name, e.g. "TEN_ARCSEC" -> "ten_arcsec". */
+auto to_lower(const std::string_view name) -> std::string {
+  std::string lower;
+  for (const char c : name) {
+    lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return lower;
+}
+
+
+/**
+ * @brief Write the translation unit of the kernel of the given planet and precision tier.
+ * @param dir The output directory. The file is named after the planet and the tier, e.g. `ear_full.cpp`.
+ * @param planet_name The name of `planet`, e.g. "EAR".
+ * @param precision_name The name of `precision`, e.g. "FULL".
+ */
+template <Planet planet, Precision precision>
+auto write_kernel(const std::filesystem::path& dir, const std::string_view planet_name, const std::string_view precision_name) -> void {
+  const auto path = dir / std::format("{}_{}.cpp", to_lower(planet_name), to_lower(precision_name));
+  std::ofstream out { path };
+  if (not out) {
+    throw std::runtime_error { std::format("Failed to open {}", path.string()) };
+  }
+
+  out << std::format("// Generated by gen_vsop87d_kernels. Do not edit.\n");
+  out << std::format("// The VSOP87D kernel of Planet::{}, Precision::{}. See `astro::vsop87d::kernels`.\n\n", planet_name, precision_name);
+  out << std::format("#include \"vsop87d/kernels.hpp\"\n\n");
+  out << std::format("namespace astro::vsop87d::kernels {{\n\n");
+  out << std::format("namespace {{\n\n");
+
+  using Tier = typename PlannetTables<planet>::template Tier<precision>;
+  std::string body;
+  const std::string λ = write_series(out, "L", Tier::L, body);
+  const std::string β = write_series(out, "B", Tier::B, body);
+  const std::string r = write_series(out, "R", Tier::R, body);
+
+  out << std::format("}} // namespace\n\n");
+  out << std::format("template <>\n");
+  out << std::format("auto evaluate<Planet::{}, Precision::{}>(const double jm) -> Evaluation {{\n", planet_name, precision_name);
+  out << std::format("{}\n", body);
+  out << std::format("  return {{\n    .λ = {},\n    .β = {},\n    .r = {},\n  }};\n}}\n\n", λ, β, r);
+  out << std::format("}} // namespace astro::vsop87d::kernels\n");
+
+  if (not out) {
+    throw std::runtime_error { std::format("Failed to write {}", path.string()) };
+  }
+}
+
+
+/** @brief Write the kernels of all the precision tiers of the given planet. */
+template <Planet planet>
+auto write_planet(const std::filesystem::path& dir, const std::string_view planet_name) -> void {
+  write_kernel<planet, Precision::FULL>(dir, planet_name, "FULL");
+  write_kernel<planet, Precision::ARCSEC>(dir, planet_name, "ARCSEC");
+  write_kernel<planet, Precision::TEN_ARCSEC>(dir, planet_name, "TEN_ARCSEC");
+  write_kernel<planet, Precision::ARCMIN>(dir, planet_name, "ARCMIN");
+}
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  if (args.size() != 2) {
+    std::println("Usage: {} <output-dir>", args[0]);
+    return 1;
+  }
+
+  try {
+    const std::filesystem::path dir { args[1] };
+    std::filesystem::create_directories(dir);
+
+    write_planet<Planet::EAR>(dir, "EAR");
+
+  } catch (const std::exception& e) {
+    std::println("Failed: {}", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Report the accuracy and the cost of the ELP/MPP02 series against the amplitude threshold.
+// For every threshold, the number of terms evaluated, the time per epoch, and the largest differences from
+// the full series are reported, as well as the time of the truncation of Meeus, `elp2000_82b::evaluate_harmonic`.
+//
+// Usage: report_elpmpp02 <binary-path> [epochs]
+
+#include <cmath>
+#include <print>
+#include <span>
+#include <string>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <exception>
+#include <functional>
+
+#include "elp2000_82b.hpp"
+#include "elpmpp02/elpmpp02.hpp"
+
+namespace elpmpp02 = astro::elpmpp02;
+
+
+/** @brief Return the time per epoch of the evaluator, in nanoseconds, the fastest of a few rounds. */
+auto time(const std::function<double(double)>& evaluator, const std::vector<double>& jcs) -> double {
+  constexpr std::size_t ROUNDS = 5;
+
+  double ns_per_epoch = INFINITY;
+  double sink = 0.0; // Keeps the evaluations from being optimized away.
+  for (std::size_t round = 0; round < ROUNDS; ++round) {
+    const auto begin = std::chrono::steady_clock::now();
+    for (const double jc : jcs) {
+      sink += evaluator(jc);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    ns_per_epoch = std::min(ns_per_epoch, elapsed.count() / static_cast<double>(jcs.size()));
+  }
+  return std::isnan(sink) ? INFINITY : ns_per_epoch;
+}
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  if (args.size() < 2) {
+    std::println("Usage: {} <binary-path> [epochs]", args[0]);
+    return 1;
+  }
+  const std::size_t count = args.size() > 2 ? std::stoul(args[2]) : 2000;
+
+  std::unique_ptr<elpmpp02::Series> series;
+  try {
+    series = std::make_unique<elpmpp02::Series>(elpmpp02::load_binary(args[1]));
+  } catch (const std::exception& e) {
+    std::println("{}", e.what());
+    return 1;
+  }
+
+  // The epochs are spread evenly over the years 1500 to 2500.
+  std::vector<double> jcs(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    jcs[i] = -5.0 + 10.0 * static_cast<double>(i) / static_cast<double>(count);
+  }
+  std::vector<elpmpp02::Evaluation> full(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    full[i] = series->evaluate(jcs[i]);
+  }
+
+  const double meeus_ns = time([](const double jc) { return astro::elp2000_82b::evaluate_harmonic(jc).Σl; }, jcs);
+  std::println("{} terms, {} epochs over the years 1500 to 2500, SIMD lanes: {}", series->term_count(), count, astro::simd::LANES);
+  std::println("Meeus (elp2000_82b::evaluate_harmonic): {:.0f} ns/epoch\n", meeus_ns);
+  std::println("{:>12}{:>10}{:>14}{:>10}{:>16}{:>16}{:>16}", "Threshold\"", "Terms", "ns/epoch", "xMeeus", "Max ΔV\"", "Max ΔU\"", "Max Δr km");
+
+  for (const double threshold : { 0.0, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.0 }) {
+    double ΔV = 0.0, ΔU = 0.0, Δr = 0.0;
+    std::size_t terms = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto truncated = series->evaluate(jcs[i], threshold);
+      ΔV = std::max(ΔV, std::abs(truncated.V - full[i].V) * elpmpp02::ARCSEC_PER_RAD);
+      ΔU = std::max(ΔU, std::abs(truncated.U - full[i].U) * elpmpp02::ARCSEC_PER_RAD);
+      Δr = std::max(Δr, std::abs(truncated.r - full[i].r));
+      terms = std::max(terms, series->term_count(jcs[i], threshold));
+    }
+    const double ns = time([&](const double jc) { return series->evaluate(jc, threshold).V; }, jcs);
+    std::println("{:>12.0e}{:>10}{:>14.0f}{:>10.1f}{:>16.3e}{:>16.3e}{:>16.3e}", threshold, terms, ns, ns / meeus_ns, ΔV, ΔU, Δr);
+  }
+  return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * CelestialCalendar: 
+ *   A C++23-style library that performs astronomical calculations and date conversions among various calendars,
+ *   including Gregorian, Lunar, and Chinese Ganzhi calendars.
+ * 
+ * Copyright (C) 2024 Ningqi Wang (0xf3cd)
+ * Email: nq.maigre@gmail.com
+ * Repo : https://github.com/0xf3cd/celestial-calendar
+ *  
+ * This project is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This project is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this project. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Report the accuracy and the cost of `Precision::MIXED` against the all-double `Precision::FULL`, for the Earth.
+// 1. The largest and the RMS differences of λ, β and r, over the years -2000 to 6000 (i.e. |jm| <= 4).
+// 2. The time per epoch of both evaluations.
+// 3. The largest difference of the jieqi moments, in seconds, over the sampled years 1 to 6000 (the calendars start at year 1).
+//
+// Usage: report_vsop87d_mixed [epochs] [year-step]
+
+#include <cmath>
+#include <print>
+#include <span>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+#include "vsop87d/vsop87d.hpp"
+#include "sun.hpp"
+
+using astro::vsop87d::Planet;
+using astro::vsop87d::Precision;
+using astro::vsop87d::Evaluation;
+
+
+/** @brief Return the time per epoch of the evaluator, in nanoseconds, the fastest of a few rounds. */
+auto time(const std::function<Evaluation(double)>& evaluator, const std::vector<double>& jms) -> double {
+  constexpr std::size_t ROUNDS = 5;
+
+  double ns_per_epoch = INFINITY;
+  double sink = 0.0; // Keeps the evaluations from being optimized away.
+  for (std::size_t round = 0; round < ROUNDS; ++round) {
+    const auto begin = std::chrono::steady_clock::now();
+    for (const double jm : jms) {
+      sink += evaluator(jm).λ;
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    ns_per_epoch = std::min(ns_per_epoch, elapsed.count() / static_cast<double>(jms.size()));
+  }
+  return std::isnan(sink) ? INFINITY : ns_per_epoch;
+}
+
+
+/** @struct The largest and the RMS difference of one coordinate. */
+struct Difference {
+  double max = 0.0;
+  double sum_of_squares = 0.0;
+
+  auto add(const double lhs, const double rhs) -> void {
+    const double difference = std::abs(lhs - rhs);
+    max = std::max(max, difference);
+    sum_of_squares += difference * difference;
+  }
+
+  [[nodiscard]] auto rms(const std::size_t count) const -> double {
+    return std::sqrt(sum_of_squares / static_cast<double>(count));
+  }
+};
+
+
+auto main(const int argc, char* argv[]) -> int { // NOLINT(bugprone-exception-escape)
+  const std::span args { argv, static_cast<std::size_t>(argc) };
+  const std::size_t count     = args.size() > 1 ? std::stoul(args[1]) : 100000;
+  const int32_t     year_step = args.size() > 2 ? std::stoi(args[2]) : 50;
+
+  // The epochs are spread evenly over the years -2000 to 6000.
+  std::vector<double> jms(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    jms[i] = -4.0 + 8.0 * static_cast<double>(i) / static_cast<double>(count);
+  }
+
+  // 1. Accuracy.
+  Difference λ, β, r;
+  for (const double jm : jms) {
+    const Evaluation full  = astro::vsop87d::evaluate<Planet::EAR, Precision::FULL>(jm);
+    const Evaluation mixed = astro::vsop87d::evaluate<Planet::EAR, Precision::MIXED>(jm);
+    λ.add(full.λ, mixed.λ);
+    β.add(full.β, mixed.β);
+    r.add(full.r, mixed.r);
+  }
+
+  std::println("Planet::EAR, {} epochs over |jm| <= 4, MIXED_THRESHOLD = {:.0e}, MIXED_TOLERANCE = {:.0e}\n",
+    count, astro::vsop87d::MIXED_THRESHOLD, astro::vsop87d::MIXED_TOLERANCE);
+  std::println("{:<6}{:>16}{:>16}", "", "Max diff", "RMS diff");
+  std::println("{:<6}{:>16.3e}{:>16.3e}", "λ", λ.max, λ.rms(count));
+  std::println("{:<6}{:>16.3e}{:>16.3e}", "β", β.max, β.rms(count));
+  std::println("{:<6}{:>16.3e}{:>16.3e}", "r", r.max, r.rms(count));
+
+  // 2. Cost, on every 10th epoch.
+  std::vector<double> timed_jms;
+  for (std::size_t i = 0; i < count; i += 10) {
+    timed_jms.emplace_back(jms[i]);
+  }
+  const double full_ns  = time(astro::vsop87d::evaluate<Planet::EAR, Precision::FULL>, timed_jms);
+  const double mixed_ns = time(astro::vsop87d::evaluate<Planet::EAR, Precision::MIXED>, timed_jms);
+  std::println("\nSIMD lanes: {} doubles, {} floats", astro::simd::LANES, astro::simd::FLOAT_LANES);
+  std::println("FULL: {:.1f} ns/epoch, MIXED: {:.1f} ns/epoch, speedup: {:.2f}x", full_ns, mixed_ns, full_ns / mixed_ns);
+
+  // 3. The jieqi moments, i.e. the roots of every 15° of solar longitude.
+  namespace math = astro::sun::geocentric_coord::math;
+
+  double max_seconds = 0.0;
+  std::size_t roots = 0;
+  for (int32_t year = 1; year <= 6000; year += year_step) {
+    for (int32_t k = 0; k < 24; ++k) {
+      const double lon = 15.0 * static_cast<double>(k);
+      const auto full  = math::find_roots<Precision::FULL>(year, lon);
+      const auto mixed = math::find_roots<Precision::MIXED>(year, lon);
+      if (full.size() != mixed.size()) {
+        std::println("Year {}, {}°: {} roots with FULL, but {} with MIXED", year, lon, full.size(), mixed.size());
+        return 1;
+      }
+      for (std::size_t i = 0; i < full.size(); ++i) {
+        max_seconds = std::max(max_seconds, std::abs(full[i] - mixed[i]) * 86400.0);
+      }
+      roots += full.size();
+    }
+  }
+  std::println("\nJieqi moments: {} roots over the years 1 to 6000 (every {} years), max diff {:.3e} seconds", roots, year_step, max_seconds);
+
+  return 0;
+}
@@ -214,6 +214,11 @@ LIB.sun_apparent_geocentric_coord.restype = _SunCoordinate
 LIB.moon_apparent_geocentric_coord.argtypes = [c_double]
 LIB.moon_apparent_geocentric_coord.restype = _MoonCoordinate
 
+LIB.moon_apparent_geocentric_coords.argtypes = [
+  POINTER(c_double), c_uint32, POINTER(c_double), POINTER(c_double), POINTER(c_double)
+]
+LIB.moon_apparent_geocentric_coords.restype = c_uint32
+
 
 @dataclass
 class SunCoordinate:
@@ -262,6 +267,21 @@ def moon_apparent_geocentric_coord(jde: float) -> MoonCoordinate:
     r   = coord.r,
   )
 
+def moon_apparent_geocentric_coords(jdes: List[float]) -> List[MoonCoordinate]:
+  """
+  @brief Compute the apparent geocentric coordinates of the Moon for many epochs in one call.
+  @param jdes The julian ephemeris day numbers, which are based on TT.
+  @returns A list of `MoonCoordinate`, one for each of `jdes`.
+  """
+  count = len(jdes)
+  inputs = (c_double * count)(*jdes)
+  lons, lats, rs = (c_double * count)(), (c_double * count)(), (c_double * count)()
+
+  if LIB.moon_apparent_geocentric_coords(inputs, count, lons, lats, rs) != count:
+    raise ValueError("Error occurred in moon_apparent_geocentric_coords.")
+
+  return [MoonCoordinate(lon = lon, lat = lat, r = r) for lon, lat, r in zip(lons, lats, rs)]
+
 #endregion
 
 